@@ -0,0 +1,368 @@
+// Performance harness for the reader, writer and codec hot paths.
+//
+// Generates a synthetic COPC file, times each operation over a number of iterations and prints the results as JSON,
+// so they can be compared between releases.
+//
+// Usage: copc_benchmarks [--depth D] [--points-per-node N] [--iterations I] [--threads T]
+//                        [--file PATH] [--output PATH]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <copc-lib/geometry/box.hpp>
+#include <copc-lib/hierarchy/key.hpp>
+#include <copc-lib/io/copc_reader.hpp>
+#include <copc-lib/io/copc_writer.hpp>
+#include <copc-lib/las/header.hpp>
+#include <copc-lib/las/points.hpp>
+#include <copc-lib/laz/compressor.hpp>
+#include <copc-lib/laz/decompressor.hpp>
+
+using namespace copc;
+using namespace std;
+
+namespace
+{
+
+struct Options
+{
+    int32_t depth{2};
+    int points_per_node{10000};
+    int iterations{5};
+    unsigned int num_threads{0};
+    string file_path{"copc_benchmark.copc.laz"};
+    string output_path;
+};
+
+struct Result
+{
+    string name;
+    vector<double> seconds;
+    uint64_t points{0};
+};
+
+const int8_t kPointFormatId = 8;
+const Vector3 kScale(0.01, 0.01, 0.01);
+const Vector3 kOffset(0, 0, 0);
+const double kHalfSize = 512;
+
+void PrintUsage()
+{
+    cerr << "Usage: copc_benchmarks [--depth D] [--points-per-node N] [--iterations I] [--threads T]"
+         << " [--file PATH] [--output PATH]" << endl;
+}
+
+Options ParseArgs(int argc, char *argv[])
+{
+    Options options;
+    for (int i = 1; i < argc; i++)
+    {
+        string arg = argv[i];
+        if (arg == "--help" || arg == "-h")
+        {
+            PrintUsage();
+            exit(0);
+        }
+        if (i + 1 >= argc)
+            throw runtime_error("Missing value for argument " + arg);
+
+        string value = argv[++i];
+        if (arg == "--depth")
+            options.depth = stoi(value);
+        else if (arg == "--points-per-node")
+            options.points_per_node = stoi(value);
+        else if (arg == "--iterations")
+            options.iterations = stoi(value);
+        else if (arg == "--threads")
+            options.num_threads = static_cast<unsigned int>(stoul(value));
+        else if (arg == "--file")
+            options.file_path = value;
+        else if (arg == "--output")
+            options.output_path = value;
+        else
+            throw runtime_error("Unknown argument " + arg);
+    }
+
+    if (options.depth < 0 || options.points_per_node <= 0 || options.iterations <= 0)
+        throw runtime_error("depth must be >= 0, points-per-node and iterations must be > 0");
+    return options;
+}
+
+// Runs `func` `iterations` times and records the wall time of each run
+// `func` returns the number of points it processed
+Result Run(const string &name, int iterations, const function<uint64_t()> &func)
+{
+    Result result;
+    result.name = name;
+    for (int i = 0; i < iterations; i++)
+    {
+        auto start = chrono::steady_clock::now();
+        result.points = func();
+        auto end = chrono::steady_clock::now();
+        result.seconds.push_back(chrono::duration<double>(end - start).count());
+    }
+    cerr << name << ": " << *min_element(result.seconds.begin(), result.seconds.end()) << "s" << endl;
+    return result;
+}
+
+las::LasHeader MakeHeader()
+{
+    CopcConfigWriter cfg(kPointFormatId, kScale, kOffset);
+    auto header = *cfg.LasHeader();
+    header.min = Vector3(0, 0, 0);
+    header.max = Vector3(2 * kHalfSize, 2 * kHalfSize, 2 * kHalfSize);
+    return header;
+}
+
+// All the keys of a full octree down to `depth`
+vector<VoxelKey> MakeKeys(int32_t depth)
+{
+    vector<VoxelKey> keys{VoxelKey::RootKey()};
+    for (size_t i = 0; i < keys.size(); i++)
+    {
+        if (keys[i].d >= depth)
+            continue;
+        for (const auto &child : keys[i].GetChildren())
+            keys.push_back(child);
+    }
+    return keys;
+}
+
+// Random points that fall within the bounds of `key`
+las::Points MakePoints(const VoxelKey &key, const las::LasHeader &header, int count, mt19937 &gen)
+{
+    Box box(key, header);
+    uniform_real_distribution<double> x_dist(box.x_min, box.x_max);
+    uniform_real_distribution<double> y_dist(box.y_min, box.y_max);
+    uniform_real_distribution<double> z_dist(box.z_min, box.z_max);
+    uniform_int_distribution<int> int_dist(0, std::numeric_limits<uint16_t>::max());
+
+    las::Points points(header);
+    points.Reserve(count);
+    for (int i = 0; i < count; i++)
+    {
+        auto point = points.CreatePoint();
+        point->X(x_dist(gen));
+        point->Y(y_dist(gen));
+        point->Z(z_dist(gen));
+        point->Intensity(int_dist(gen));
+        point->ReturnNumber(1 + int_dist(gen) % 15);
+        point->NumberOfReturns(15);
+        point->Classification(int_dist(gen) % 32);
+        point->UserData(int_dist(gen) % 256);
+        point->ScanAngle(int_dist(gen) % 1000);
+        point->PointSourceId(int_dist(gen));
+        point->GPSTime(i * 0.001);
+        point->Rgb(int_dist(gen), int_dist(gen), int_dist(gen));
+        point->Nir(int_dist(gen));
+        points.AddPoint(point);
+    }
+    return points;
+}
+
+uint64_t WriteFile(const Options &options, const vector<VoxelKey> &keys, const vector<las::Points> &node_points,
+                   bool parallel_compression)
+{
+    CopcConfigWriter cfg(kPointFormatId, kScale, kOffset);
+    auto header = MakeHeader();
+    cfg.LasHeader()->min = header.min;
+    cfg.LasHeader()->max = header.max;
+    cfg.CopcInfo()->center_x = kHalfSize;
+    cfg.CopcInfo()->center_y = kHalfSize;
+    cfg.CopcInfo()->center_z = kHalfSize;
+    cfg.CopcInfo()->halfsize = kHalfSize;
+    cfg.CopcInfo()->spacing = 2 * kHalfSize / 128;
+
+    FileWriter writer(options.file_path, cfg);
+    if (parallel_compression)
+        writer.EnableParallelCompression(options.num_threads);
+    uint64_t point_count = 0;
+    for (size_t i = 0; i < keys.size(); i++)
+    {
+        writer.AddNode(keys[i], node_points[i]);
+        point_count += node_points[i].Size();
+    }
+    writer.Close();
+    return point_count;
+}
+
+string ToJson(const Options &options, size_t node_count, const vector<Result> &results)
+{
+    stringstream ss;
+    ss.precision(9);
+    ss << "{\n";
+    ss << "  \"config\": {\"depth\": " << options.depth << ", \"points_per_node\": " << options.points_per_node
+       << ", \"nodes\": " << node_count << ", \"iterations\": " << options.iterations
+       << ", \"threads\": " << options.num_threads << "},\n";
+    ss << "  \"benchmarks\": [\n";
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        const auto &result = results[i];
+        double min_s = *min_element(result.seconds.begin(), result.seconds.end());
+        double max_s = *max_element(result.seconds.begin(), result.seconds.end());
+        double mean_s = 0;
+        for (const auto &s : result.seconds)
+            mean_s += s;
+        mean_s /= result.seconds.size();
+
+        ss << "    {\"name\": \"" << result.name << "\", \"points\": " << result.points << ", \"min_s\": " << min_s
+           << ", \"mean_s\": " << mean_s << ", \"max_s\": " << max_s
+           << ", \"points_per_s\": " << (min_s > 0 ? result.points / min_s : 0) << "}";
+        ss << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    ss << "  ]\n}\n";
+    return ss.str();
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    Options options;
+    try
+    {
+        options = ParseArgs(argc, argv);
+    }
+    catch (const exception &e)
+    {
+        cerr << e.what() << endl;
+        PrintUsage();
+        return 1;
+    }
+
+    // Synthetic dataset: a full octree down to the requested depth, with the same number of points in every node
+    auto header = MakeHeader();
+    auto keys = MakeKeys(options.depth);
+    mt19937 gen(0);
+    vector<las::Points> node_points;
+    node_points.reserve(keys.size());
+    for (const auto &key : keys)
+        node_points.push_back(MakePoints(key, header, options.points_per_node, gen));
+
+    vector<Result> results;
+
+    // Writer
+    results.push_back(Run("writer_add_node_close_parallel", options.iterations,
+                          [&] { return WriteFile(options, keys, node_points, true); }));
+    results.push_back(Run("writer_add_node_close", options.iterations,
+                          [&] { return WriteFile(options, keys, node_points, false); }));
+
+    // Reader
+    results.push_back(Run("reader_get_all_nodes", options.iterations,
+                          [&]
+                          {
+                              FileReader reader(options.file_path);
+                              return static_cast<uint64_t>(reader.GetAllNodes().size());
+                          }));
+
+    results.push_back(Run("reader_find_node", options.iterations,
+                          [&]
+                          {
+                              FileReader find_reader(options.file_path);
+                              find_reader.LoadHierarchy();
+                              uint64_t found = 0;
+                              for (const auto &key : keys)
+                                  found += find_reader.FindNode(key).IsValid();
+                              return found;
+                          }));
+
+    FileReader reader(options.file_path);
+    auto nodes = reader.GetAllNodes();
+    results.push_back(Run("reader_get_points", options.iterations,
+                          [&]
+                          {
+                              uint64_t point_count = 0;
+                              for (const auto &node : nodes)
+                                  point_count += reader.GetPoints(node).Size();
+                              return point_count;
+                          }));
+    results.push_back(Run("reader_get_points_batch", options.iterations,
+                          [&]
+                          {
+                              uint64_t point_count = 0;
+                              for (const auto &points : reader.GetPoints(nodes, options.num_threads))
+                                  point_count += points.Size();
+                              return point_count;
+                          }));
+
+    // A box covering the center of the dataset, which cuts through nodes at every level
+    Box box(kHalfSize / 2, kHalfSize / 2, kHalfSize / 2, 3 * kHalfSize / 2, 3 * kHalfSize / 2, 3 * kHalfSize / 2);
+    results.push_back(Run("reader_get_points_within_box", options.iterations,
+                          [&]
+                          {
+                              FileReader box_reader(options.file_path);
+                              return static_cast<uint64_t>(
+                                  box_reader.GetPointsWithinBox(box, 0, options.num_threads).Size());
+                          }));
+
+    // Codecs, on the data of the root node
+    auto las_header = reader.CopcConfig().LasHeader();
+    const auto &root_points = node_points.front();
+    auto uncompressed = root_points.Pack(las_header);
+    auto compressed = laz::Compressor::CompressBytes(uncompressed, las_header);
+    auto root_count = static_cast<uint64_t>(root_points.Size());
+
+    results.push_back(Run("points_pack", options.iterations,
+                          [&]
+                          {
+                              auto packed = root_points.Pack(las_header);
+                              return static_cast<uint64_t>(packed.size() / las_header.PointRecordLength());
+                          }));
+    results.push_back(Run("points_unpack", options.iterations,
+                          [&] { return static_cast<uint64_t>(las::Points::Unpack(uncompressed, las_header).Size()); }));
+    results.push_back(Run("laz_compress", options.iterations,
+                          [&]
+                          {
+                              laz::Compressor::CompressBytes(uncompressed, las_header);
+                              return root_count;
+                          }));
+    results.push_back(Run("laz_decompress", options.iterations,
+                          [&]
+                          {
+                              laz::Decompressor::DecompressBytes(compressed, las_header,
+                                                                 static_cast<int>(root_count));
+                              return root_count;
+                          }));
+
+    // Many small chunks, like the nodes near the root of real octrees, where building the codec for every chunk
+    // weighs the most
+    const size_t kSmallChunkPoints = 300;
+    auto record_length = static_cast<size_t>(las_header.PointRecordLength());
+    vector<vector<char>> small_chunks;
+    for (size_t first = 0; first + kSmallChunkPoints <= root_count; first += kSmallChunkPoints)
+        small_chunks.push_back(laz::Compressor::CompressBytes(uncompressed.data() + first * record_length,
+                                                              kSmallChunkPoints * record_length,
+                                                              las_header.PointFormatId(), las_header.EbByteSize()));
+    vector<char> small_out(kSmallChunkPoints * record_length);
+    results.push_back(Run("laz_decompress_small_chunks", options.iterations,
+                          [&]
+                          {
+                              for (const auto &chunk : small_chunks)
+                                  laz::Decompressor::DecompressBytes(chunk.data(), chunk.size(), las_header,
+                                                                     static_cast<int>(kSmallChunkPoints),
+                                                                     small_out.data(), small_out.size());
+                              return static_cast<uint64_t>(small_chunks.size() * kSmallChunkPoints);
+                          }));
+
+    auto json = ToJson(options, keys.size(), results);
+    if (options.output_path.empty())
+    {
+        cout << json;
+    }
+    else
+    {
+        ofstream out(options.output_path);
+        out << json;
+    }
+    return 0;
+}
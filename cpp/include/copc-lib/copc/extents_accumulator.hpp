@@ -0,0 +1,68 @@
+#ifndef COPCLIB_COPC_EXTENTS_ACCUMULATOR_H_
+#define COPCLIB_COPC_EXTENTS_ACCUMULATOR_H_
+
+#include <array>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+#include "copc-lib/copc/extents.hpp"
+#include "copc-lib/copc/node_stats.hpp"
+#include "copc-lib/las/header.hpp"
+#include "copc-lib/las/point_buffer.hpp"
+
+namespace copc
+{
+
+// Running min/max, mean and variance of each PointField, which writers keep up to date as points are added so the
+// header's bounds and CopcExtents don't need a second pass over the data (see Writer::EnableAutoExtents).
+// Mean and variance are combined with Chan's parallel formula, so accumulators filled on different threads can be
+// merged in any order.
+class ExtentsAccumulator
+{
+  public:
+    ExtentsAccumulator() = default;
+
+    // Adds every field the buffer holds
+    void Add(const las::PointBuffer &points);
+    // Adds the points of another accumulator, only the fields that both hold are kept
+    void Merge(const ExtentsAccumulator &other);
+
+    uint64_t PointCount() const { return point_count_; }
+    bool HasField(PointField field) const { return field < FIELD_COUNT && (fields_ & (1u << field)) != 0; }
+    // Extent of the field, with its population variance
+    // Throws if the accumulator doesn't hold the field
+    CopcExtent Extent(PointField field) const;
+
+    // Sets the extents of the fields the accumulator holds, with the scan angle converted to degrees
+    // Extra byte extents are left as they are
+    void Apply(CopcExtents &extents) const;
+    // Sets the header's XYZ min/max, or zeros them if the accumulator doesn't hold XYZ
+    void ApplyBounds(las::LasHeader &header) const;
+
+    std::string ToString() const;
+    friend std::ostream &operator<<(std::ostream &os, ExtentsAccumulator const &value)
+    {
+        os << value.ToString();
+        return os;
+    }
+
+  private:
+    struct Moments
+    {
+        double minimum{0};
+        double maximum{0};
+        double mean{0};
+        // Sum of the squared differences to the mean
+        double m2{0};
+    };
+
+    uint64_t point_count_{0};
+    // Bit mask of the PointFields that are accumulated
+    uint32_t fields_{0};
+    std::array<Moments, FIELD_COUNT> moments_{};
+};
+
+} // namespace copc
+
+#endif // COPCLIB_COPC_EXTENTS_ACCUMULATOR_H_
@@ -0,0 +1,161 @@
+#ifndef COPCLIB_COPC_NODE_STATS_H_
+#define COPCLIB_COPC_NODE_STATS_H_
+
+#include <array>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "copc-lib/hierarchy/key.hpp"
+#include "copc-lib/las/point_buffer.hpp"
+
+namespace copc
+{
+
+// Point attributes that statistics and filters can be computed on, in the order of CopcExtents
+// Values are the ones stored in a PointBuffer, so XYZ are scaled, and the scan angle is in its raw 0.006 degree steps
+enum PointField : uint8_t
+{
+    FIELD_X,
+    FIELD_Y,
+    FIELD_Z,
+    FIELD_INTENSITY,
+    FIELD_RETURN_NUMBER,
+    FIELD_NUMBER_OF_RETURNS,
+    FIELD_SCANNER_CHANNEL,
+    FIELD_SCAN_DIRECTION_FLAG,
+    FIELD_EDGE_OF_FLIGHT_LINE,
+    FIELD_CLASSIFICATION,
+    FIELD_USER_DATA,
+    FIELD_SCAN_ANGLE,
+    FIELD_POINT_SOURCE_ID,
+    FIELD_GPS_TIME,
+    FIELD_RED,
+    FIELD_GREEN,
+    FIELD_BLUE,
+    FIELD_NIR,
+    FIELD_COUNT
+};
+
+// The las::Dimension a PointBuffer must hold to have the field
+uint32_t FieldDimension(PointField field);
+std::string FieldName(PointField field);
+
+// Summary of the points of a node: min/max of each field, and a histogram of the classifications
+// This is a per-node version of what CopcExtents stores for the whole file, so readers can rule out nodes without
+// decompressing them (see PointFilter::MayMatch).
+class NodeStats
+{
+  public:
+    // IDs of the node statistics EVLR
+    static constexpr const char *VLR_USER_ID = "rock_robotic";
+    static constexpr uint16_t VLR_RECORD_ID = 10002;
+
+    NodeStats() = default;
+    // Computes the stats of every field the buffer holds
+    static NodeStats FromPoints(const las::PointBuffer &points);
+
+    // Combines the stats of two sets of points, only the fields that both hold are kept
+    void Merge(const NodeStats &other);
+
+    uint64_t PointCount() const { return point_count_; }
+    bool HasField(PointField field) const { return field < FIELD_COUNT && (fields_ & (1u << field)) != 0; }
+    // Throws if the stats don't hold the field
+    double Minimum(PointField field) const;
+    double Maximum(PointField field) const;
+    bool HasClassificationCounts() const { return HasField(FIELD_CLASSIFICATION); }
+    // Number of points of the given class, 0 if the stats don't hold classifications
+    uint64_t ClassificationCount(uint8_t classification) const;
+    // (class, count) of every class that has points, in increasing class order
+    const std::vector<std::pair<uint8_t, uint64_t>> &ClassificationCounts() const { return classification_counts_; }
+
+    // Pack/unpack, as little-endian binary
+    void Pack(std::ostream &out_stream) const;
+    static NodeStats Unpack(std::istream &in_stream);
+
+    // The node statistics EVLR holds each node's key (d, x, y, z as int32) followed by its packed stats
+    static std::vector<char> PackNodes(const std::unordered_map<VoxelKey, NodeStats> &nodes);
+    static std::unordered_map<VoxelKey, NodeStats> UnpackNodes(const std::vector<char> &data);
+
+    std::string ToString() const;
+    friend std::ostream &operator<<(std::ostream &os, NodeStats const &value)
+    {
+        os << value.ToString();
+        return os;
+    }
+
+  private:
+    uint64_t point_count_{0};
+    // Bit mask of the PointFields that have min/max
+    uint32_t fields_{0};
+    std::array<double, FIELD_COUNT> minimum_{};
+    std::array<double, FIELD_COUNT> maximum_{};
+    // Sparse, since nodes usually hold few classes
+    std::vector<std::pair<uint8_t, uint64_t>> classification_counts_;
+};
+
+namespace Internal
+{
+// Calls `f(column, value)` with the PointBuffer column that holds the field, and a function that extracts the
+// field's value out of an element of that column (for fields stored in a bit field)
+template <typename F> void VisitField(const las::PointBuffer &points, PointField field, F &&f)
+{
+    auto identity = [](auto v) { return v; };
+    switch (field)
+    {
+    case FIELD_X:
+        return f(points.X(), identity);
+    case FIELD_Y:
+        return f(points.Y(), identity);
+    case FIELD_Z:
+        return f(points.Z(), identity);
+    case FIELD_INTENSITY:
+        return f(points.Intensity(), identity);
+    case FIELD_RETURN_NUMBER:
+        return f(points.ReturnsBitField(), [](uint8_t v) { return static_cast<uint8_t>(v & 0xF); });
+    case FIELD_NUMBER_OF_RETURNS:
+        return f(points.ReturnsBitField(), [](uint8_t v) { return static_cast<uint8_t>(v >> 4); });
+    case FIELD_SCANNER_CHANNEL:
+        return f(points.FlagsBitField(), [](uint8_t v) { return static_cast<uint8_t>((v >> 4) & 0x3); });
+    case FIELD_SCAN_DIRECTION_FLAG:
+        return f(points.FlagsBitField(), [](uint8_t v) { return static_cast<uint8_t>((v >> 6) & 0x1); });
+    case FIELD_EDGE_OF_FLIGHT_LINE:
+        return f(points.FlagsBitField(), [](uint8_t v) { return static_cast<uint8_t>(v >> 7); });
+    case FIELD_CLASSIFICATION:
+        return f(points.Classification(), identity);
+    case FIELD_USER_DATA:
+        return f(points.UserData(), identity);
+    case FIELD_SCAN_ANGLE:
+        return f(points.ScanAngle(), identity);
+    case FIELD_POINT_SOURCE_ID:
+        return f(points.PointSourceId(), identity);
+    case FIELD_GPS_TIME:
+        return f(points.GPSTime(), identity);
+    case FIELD_RED:
+        return f(points.Red(), identity);
+    case FIELD_GREEN:
+        return f(points.Green(), identity);
+    case FIELD_BLUE:
+        return f(points.Blue(), identity);
+    case FIELD_NIR:
+        return f(points.Nir(), identity);
+    default:
+        throw std::runtime_error("VisitField: Invalid point field.");
+    }
+}
+
+// Whether the buffer has the field's column, dimensions the point format doesn't have are never held
+inline bool HoldsField(const las::PointBuffer &points, PointField field)
+{
+    return points.HasDimension(static_cast<las::Dimension>(FieldDimension(field)));
+}
+} // namespace Internal
+
+} // namespace copc
+
+#endif // COPCLIB_COPC_NODE_STATS_H_
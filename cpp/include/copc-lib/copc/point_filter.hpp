@@ -0,0 +1,65 @@
+#ifndef COPCLIB_COPC_POINT_FILTER_H_
+#define COPCLIB_COPC_POINT_FILTER_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "copc-lib/copc/node_stats.hpp"
+#include "copc-lib/las/point_buffer.hpp"
+
+namespace copc
+{
+
+// Attribute filter over points, made of conditions on PointFields that must all hold, e.g.
+//   PointFilter().In(FIELD_CLASSIFICATION, {2, 6}).Range(FIELD_GPS_TIME, t0, t1)
+// Readers use it to skip the nodes whose NodeStats show that none of their points can pass (see
+// Reader::GetNodesWithFilter), and filter the points of the other nodes column by column.
+// An empty filter keeps every point.
+class PointFilter
+{
+  public:
+    PointFilter() = default;
+
+    // Keeps the points whose field is within [minimum, maximum]
+    PointFilter &Range(PointField field, double minimum, double maximum);
+    // Keeps the points whose field is one of `values`
+    PointFilter &In(PointField field, const std::vector<double> &values);
+
+    bool Empty() const { return conditions_.empty(); }
+    // Mask of the las::Dimensions a PointBuffer must hold to be filtered
+    uint32_t RequiredDimensions() const;
+
+    // Returns false if the stats show that none of the node's points can pass the filter
+    // Conditions on fields that the stats don't hold can't rule a node out
+    bool MayMatch(const NodeStats &stats) const;
+    // Sets out[i] to 1 if point i passes the filter, and 0 otherwise
+    // Throws if the buffer doesn't hold the required dimensions
+    std::vector<uint8_t> Mask(const las::PointBuffer &points) const;
+    // Returns the points that pass the filter
+    las::PointBuffer Apply(const las::PointBuffer &points) const;
+
+    std::string ToString() const;
+    friend std::ostream &operator<<(std::ostream &os, PointFilter const &value)
+    {
+        os << value.ToString();
+        return os;
+    }
+
+  private:
+    struct Condition
+    {
+        PointField field;
+        // Range conditions use minimum/maximum, the others use values
+        bool is_range;
+        double minimum;
+        double maximum;
+        std::vector<double> values;
+    };
+
+    std::vector<Condition> conditions_;
+};
+
+} // namespace copc
+
+#endif // COPCLIB_COPC_POINT_FILTER_H_
@@ -1,6 +1,7 @@
 #ifndef COPCLIB_HIERARCHY_ENTRY_H_
 #define COPCLIB_HIERARCHY_ENTRY_H_
 
+#include <cstring>
 #include <ostream>
 #include <vector>
 
@@ -66,6 +67,29 @@ class Entry
         return Entry(key, offset, size, point_count);
     }
 
+    // Unpacks an entry from a buffer of at least ENTRY_SIZE bytes
+    static Entry Unpack(const char *data)
+    {
+        VoxelKey key;
+        std::memcpy(&key.d, data, sizeof(key.d));
+        std::memcpy(&key.x, data + 4, sizeof(key.x));
+        std::memcpy(&key.y, data + 8, sizeof(key.y));
+        std::memcpy(&key.z, data + 12, sizeof(key.z));
+
+        uint64_t offset;
+        std::memcpy(&offset, data + 16, sizeof(offset));
+        int32_t size;
+        std::memcpy(&size, data + 24, sizeof(size));
+        int32_t point_count;
+        std::memcpy(&point_count, data + 28, sizeof(point_count));
+
+        return Entry(key, offset, size, point_count);
+    }
+
+    // Unpacks and validates a whole page of entries in one pass
+    // `byte_size` must be a multiple of ENTRY_SIZE, throws if any entry is invalid
+    static std::vector<Entry> UnpackEntries(const char *data, size_t byte_size);
+
     VoxelKey key;
     uint64_t offset;
     int32_t byte_size;
@@ -1,8 +1,10 @@
 #ifndef COPCLIB_HIERARCHY_HIERARCHY_H_
 #define COPCLIB_HIERARCHY_HIERARCHY_H_
 
+#include <mutex>
 #include <unordered_map>
 
+#include "copc-lib/hierarchy/internal/node_index.hpp"
 #include "copc-lib/hierarchy/internal/page.hpp"
 #include "copc-lib/hierarchy/key.hpp" // include the key so that the hash function gets in namespace
 #include "copc-lib/hierarchy/node.hpp"
@@ -27,24 +29,55 @@ class Hierarchy
         // add the root page to the pages list
         seen_pages_[VoxelKey::RootKey()] =
             std::make_shared<PageInternal>(VoxelKey::RootKey(), root_hier_offset, root_hier_size);
+        pending_pages_ = 1;
     };
 
-    // Find the lowest depth page that has been seen within a hierarchy list
-    std::shared_ptr<PageInternal> NearestLoadedPage(const std::vector<VoxelKey> &parents_list)
+    // Find the deepest page that has been seen among the key and its ancestors
+    std::shared_ptr<PageInternal> NearestLoadedPage(VoxelKey key)
     {
-        // Iterates through the list of key ancestors to find if any have been seen
-        for (auto &nearest_seen_parent : parents_list)
-            if (PageExists(nearest_seen_parent))
-                return seen_pages_[nearest_seen_parent];
-
+        // Walks up the ancestors one at a time, rather than building the list of them
+        for (; key.IsValid(); key = key.GetParent())
+        {
+            auto page = seen_pages_.find(key);
+            if (page != seen_pages_.end())
+                return page->second;
+        }
         return nullptr;
     }
 
     bool PageExists(VoxelKey key) { return seen_pages_.find(key) != seen_pages_.end(); }
-    bool NodeExists(VoxelKey key) { return loaded_nodes_.find(key) != loaded_nodes_.end(); }
+    bool NodeExists(VoxelKey key)
+    {
+        return loaded_nodes_.find(key) != loaded_nodes_.end() || node_index_.Contains(key);
+    }
+    // Looks a node up among the nodes added by the writer and the nodes read from the file
+    bool FindLoadedNode(const VoxelKey &key, Node &out)
+    {
+        auto it = loaded_nodes_.find(key);
+        if (it != loaded_nodes_.end())
+        {
+            out = *it->second;
+            return true;
+        }
+        return node_index_.Find(key, out);
+    }
+    // True once every page of the hierarchy has been read
+    bool FullyLoaded() const { return pending_pages_ == 0; }
 
     std::unordered_map<VoxelKey, std::shared_ptr<PageInternal>> seen_pages_;
+    // Nodes added by the writer, which updates them in place once they're written
     std::unordered_map<VoxelKey, std::shared_ptr<Node>> loaded_nodes_;
+    // Nodes read from the file's hierarchy pages
+    NodeIndex node_index_;
+
+    // Kept up to date as pages are parsed, so depth queries don't need to walk the loaded nodes
+    int32_t max_loaded_depth_{-1};
+    // Number of pages that have been seen but not read yet
+    size_t pending_pages_{0};
+
+    // Guards seen_pages_, loaded_nodes_ and page loading, so that readers can be shared between threads.
+    // Recursive, since page loading calls back into lookups that also take the lock.
+    std::recursive_mutex mutex_;
 };
 
 } // namespace copc::Internal
@@ -0,0 +1,200 @@
+#ifndef COPCLIB_HIERARCHY_NODE_INDEX_H_
+#define COPCLIB_HIERARCHY_NODE_INDEX_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "copc-lib/hierarchy/entry.hpp"
+#include "copc-lib/hierarchy/key.hpp"
+#include "copc-lib/hierarchy/morton_key.hpp"
+#include "copc-lib/hierarchy/node.hpp"
+
+namespace copc::Internal
+{
+// Flat storage for the nodes read from a file's hierarchy pages
+// Nodes are kept in plain records, appended a page at a time, with an array of record indices sorted in Morton
+// pre-order (see MortonKey::PreorderLess) for lookups, so a key's subtree is a contiguous run of it. This takes a
+// fraction of the memory of a map of shared Node pointers, and iterating a page's nodes walks a contiguous range.
+// Not thread-safe, the Hierarchy's mutex guards it.
+class NodeIndex
+{
+  public:
+    // Adds the node entries of a page, only the keys of its subpage entries are kept, for HasSubtree
+    void AddPage(const VoxelKey &page_key, const std::vector<Entry> &entries)
+    {
+        auto page = static_cast<uint32_t>(page_keys_.size());
+        page_keys_.push_back(page_key);
+
+        auto begin = records_.size();
+        for (const auto &e : entries)
+        {
+            if (e.IsPage())
+                sub_pages_.push_back({PreorderPosition(e.key), e.key});
+            else
+                records_.push_back({e.key, PreorderPosition(e.key), e.offset, e.byte_size, e.point_count, page});
+        }
+        page_ranges_[page_key] = {begin, records_.size()};
+    }
+
+    // Returns false if the node isn't in the index
+    bool Find(const VoxelKey &key, Node &out)
+    {
+        auto it = LowerBound(key);
+        if (it == order_.cend() || !(records_[*it].key == key))
+            return false;
+        out = ToNode(records_[*it]);
+        return true;
+    }
+
+    bool Contains(const VoxelKey &key)
+    {
+        Node node;
+        return Find(key, node);
+    }
+
+    // Appends the nodes read from the page `page_key`
+    void AppendPageNodes(const VoxelKey &page_key, std::vector<Node> &out) const
+    {
+        auto range = page_ranges_.find(page_key);
+        if (range == page_ranges_.end())
+            return;
+        out.reserve(out.size() + (range->second.second - range->second.first));
+        for (size_t i = range->second.first; i < range->second.second; i++)
+            out.push_back(ToNode(records_[i]));
+    }
+
+    // True if a node or a subpage entry is in the subtree of `key`, the key itself included
+    // Since a page's subpage entries are added along with its nodes, a subtree that this returns false for, and that
+    // lies in a page that has been added, holds no node. Each subtree is a contiguous run of the pre-order, so this is
+    // two binary searches, plus a scan of the keys too deep for a MortonKey, which are sorted last
+    bool HasSubtree(const VoxelKey &key)
+    {
+        SortPending();
+        constexpr auto deepest = std::numeric_limits<uint64_t>::max();
+        if (MortonKey::Representable(key))
+        {
+            auto position = PreorderPosition(key);
+            auto end = MortonKey(key).DescendantRange().second;
+            auto node = LowerBound(key);
+            if (node != order_.cend() && records_[*node].position < end)
+                return true;
+            auto sub_page = std::lower_bound(sub_pages_.cbegin(), sub_pages_.cend(), std::make_pair(position, key),
+                                             [](const SubPage &a, const SubPage &b)
+                                             { return Less(a.first, a.second, b.first, b.second); });
+            if (sub_page != sub_pages_.cend() && sub_page->first < end)
+                return true;
+        }
+
+        for (auto node = order_.crbegin(); node != order_.crend() && records_[*node].position == deepest; node++)
+        {
+            if (records_[*node].key.ChildOf(key))
+                return true;
+        }
+        for (auto sub_page = sub_pages_.crbegin(); sub_page != sub_pages_.crend() && sub_page->first == deepest;
+             sub_page++)
+        {
+            if (sub_page->second.ChildOf(key))
+                return true;
+        }
+        return false;
+    }
+
+    size_t Size() const { return records_.size(); }
+    void Reserve(size_t node_count)
+    {
+        records_.reserve(node_count);
+        order_.reserve(node_count);
+    }
+
+  private:
+    // Pre-order position and key of a subpage entry
+    using SubPage = std::pair<uint64_t, VoxelKey>;
+
+    struct Record
+    {
+        VoxelKey key;
+        // Pre-order position of the key (see PreorderPosition), computed once so sorting doesn't rebuild MortonKeys
+        uint64_t position;
+        uint64_t offset;
+        int32_t byte_size;
+        int32_t point_count;
+        // Index of the page key in page_keys_
+        uint32_t page;
+    };
+
+    // Morton pre-order, ties between a key and its first descendants are broken by depth
+    static bool Less(uint64_t a_position, const VoxelKey &a, uint64_t b_position, const VoxelKey &b)
+    {
+        return std::tie(a_position, a.d, a.x, a.y, a.z) < std::tie(b_position, b.d, b.x, b.y, b.z);
+    }
+
+    // Keys too deep for a MortonKey go last
+    static uint64_t PreorderPosition(const VoxelKey &key)
+    {
+        if (!MortonKey::Representable(key))
+            return std::numeric_limits<uint64_t>::max();
+        return MortonKey(key).PreorderPosition();
+    }
+
+    // First entry of order_ that isn't less than `key`
+    std::vector<uint32_t>::const_iterator LowerBound(const VoxelKey &key)
+    {
+        SortPending();
+        auto position = PreorderPosition(key);
+        return std::lower_bound(order_.cbegin(), order_.cend(), key,
+                                [this, position](uint32_t i, const VoxelKey &k)
+                                { return Less(records_[i].position, records_[i].key, position, k); });
+    }
+
+    Node ToNode(const Record &record) const
+    {
+        return Node(Entry(record.key, record.offset, record.byte_size, record.point_count), page_keys_[record.page]);
+    }
+
+    // Sorts the records added since the last lookup, and merges them into the sorted order
+    // Pages can be added many at a time between lookups, so this is cheaper than keeping the order on every add
+    void SortPending()
+    {
+        if (sorted_sub_pages_ != sub_pages_.size())
+        {
+            auto less = [](const SubPage &a, const SubPage &b) { return Less(a.first, a.second, b.first, b.second); };
+            std::sort(sub_pages_.begin() + sorted_sub_pages_, sub_pages_.end(), less);
+            std::inplace_merge(sub_pages_.begin(), sub_pages_.begin() + sorted_sub_pages_, sub_pages_.end(), less);
+            sorted_sub_pages_ = sub_pages_.size();
+        }
+
+        auto sorted = order_.size();
+        if (sorted == records_.size())
+            return;
+
+        for (auto i = sorted; i < records_.size(); i++)
+            order_.push_back(static_cast<uint32_t>(i));
+        auto less = [this](uint32_t a, uint32_t b)
+        {
+            const auto &ra = records_[a];
+            const auto &rb = records_[b];
+            return Less(ra.position, ra.key, rb.position, rb.key);
+        };
+        std::sort(order_.begin() + sorted, order_.end(), less);
+        std::inplace_merge(order_.begin(), order_.begin() + sorted, order_.end(), less);
+    }
+
+    std::vector<Record> records_;
+    // Indices of records_, sorted by key
+    std::vector<uint32_t> order_;
+    std::vector<VoxelKey> page_keys_;
+    // Range of records_ that each page's nodes were added to
+    std::unordered_map<VoxelKey, std::pair<size_t, size_t>> page_ranges_;
+    // Keys of the subpage entries of the added pages, sorted like order_ up to sorted_sub_pages_
+    std::vector<SubPage> sub_pages_;
+    size_t sorted_sub_pages_{0};
+};
+
+} // namespace copc::Internal
+
+#endif // COPCLIB_HIERARCHY_NODE_INDEX_H_
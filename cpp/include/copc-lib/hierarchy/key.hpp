@@ -63,7 +63,7 @@ class VoxelKey
     // optionally including the key itself
     std::vector<VoxelKey> GetParents(bool include_self = false) const;
 
-    // Tests whether the current key is a child of a given key
+    // Tests whether the current key is a child of a given key (or the key itself), in constant time
     bool ChildOf(VoxelKey parent_key) const;
 
     // Spatial query functions
@@ -109,6 +109,20 @@ inline bool operator==(const VoxelKey &a, const VoxelKey &b)
 }
 inline bool operator!=(const VoxelKey &a, const VoxelKey &b) { return !(a == b); }
 
+namespace Internal
+{
+// Finalizer of splitmix64, spreads every bit of `h` over the whole hash
+inline uint64_t MixHash(uint64_t h)
+{
+    h ^= h >> 30;
+    h *= 0xbf58476d1ce4e5b9ull;
+    h ^= h >> 27;
+    h *= 0x94d049bb133111ebull;
+    h ^= h >> 31;
+    return h;
+}
+} // namespace Internal
+
 } // namespace copc
 
 // Hash function to allow VoxelKeys as unordered_map keys
@@ -116,11 +130,9 @@ template <> struct std::hash<copc::VoxelKey>
 {
     std::size_t operator()(copc::VoxelKey const &k) const noexcept
     {
-        std::hash<uint64_t> h;
-
-        uint64_t k1 = ((uint64_t)k.d << 32) | k.x;
-        uint64_t k2 = ((uint64_t)k.y << 32) | k.z;
-        return h(k1) ^ (h(k2) << 1);
+        uint64_t k1 = (uint64_t(uint32_t(k.d)) << 32) | uint32_t(k.x);
+        uint64_t k2 = (uint64_t(uint32_t(k.y)) << 32) | uint32_t(k.z);
+        return static_cast<std::size_t>(copc::Internal::MixHash(k1 ^ copc::Internal::MixHash(k2)));
     }
 };
 
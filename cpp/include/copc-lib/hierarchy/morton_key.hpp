@@ -0,0 +1,87 @@
+#ifndef COPCLIB_HIERARCHY_MORTON_KEY_H_
+#define COPCLIB_HIERARCHY_MORTON_KEY_H_
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "copc-lib/hierarchy/key.hpp"
+
+namespace copc
+{
+
+// A VoxelKey packed into a single 64-bit Morton (Z-order) locational code: a marker bit followed by the interleaved
+// bits of z, y and x, three per level. The low three bits of a key are its direction within its parent, as used by
+// VoxelKey::Bisect, so hierarchy arithmetic is done with shifts:
+// - the parent of a key is `code >> 3`, and its children are `code << 3 | direction`
+// - a key is a descendant of another when shifting it up to the other's depth gives the same code
+// - in pre-order (see PreorderLess), a key and all its descendants form a contiguous range
+// Keys up to MAX_DEPTH can be represented.
+class MortonKey
+{
+  public:
+    static constexpr int32_t MAX_DEPTH = 21;
+
+    MortonKey() = default;
+    // Throws if the key is invalid, deeper than MAX_DEPTH, or has a coordinate outside of its depth's grid
+    explicit MortonKey(const VoxelKey &key);
+    static MortonKey FromCode(uint64_t code);
+
+    // Whether the key can be packed into a MortonKey
+    static bool Representable(const VoxelKey &key);
+
+    bool IsValid() const { return code_ != 0; }
+    uint64_t Code() const { return code_; }
+    int32_t Depth() const;
+    VoxelKey ToVoxelKey() const;
+    std::string ToString() const;
+
+    static MortonKey RootKey() { return FromCode(1); }
+
+    // Invalid key for the root
+    MortonKey Parent() const { return Depth() > 0 ? FromCode(code_ >> 3) : MortonKey(); }
+    MortonKey ParentAtDepth(int32_t depth) const;
+    // Direction [0,7] of the key within its parent
+    int Direction() const { return static_cast<int>(code_ & 7); }
+    MortonKey Child(int direction) const;
+    std::vector<MortonKey> Children() const;
+    // The other children of the key's parent, none for the root
+    std::vector<MortonKey> Siblings() const;
+
+    // Tests whether this key is `ancestor` or one of its descendants, same as VoxelKey::ChildOf
+    bool ChildOf(const MortonKey &ancestor) const;
+
+    // Orders keys depth-first: a key comes right before its descendants, which come before its next sibling
+    // Invalid keys come first
+    static bool PreorderLess(const MortonKey &a, const MortonKey &b);
+    // Half-open range of PreorderPosition values that holds this key and all its descendants
+    // Keys of any depth whose position falls in the range and that are at least as deep as this key are its
+    // descendants, so a pre-order sorted list of keys can be range-queried with two binary searches
+    std::pair<uint64_t, uint64_t> DescendantRange() const;
+    // Position of the key's first cell at MAX_DEPTH, shared by a key and its first descendants
+    uint64_t PreorderPosition() const;
+
+  private:
+    explicit MortonKey(uint64_t code) : code_(code) {}
+
+    // 0 is never a valid code, since every key has a marker bit
+    uint64_t code_{0};
+};
+
+inline bool operator==(const MortonKey &a, const MortonKey &b) { return a.Code() == b.Code(); }
+inline bool operator!=(const MortonKey &a, const MortonKey &b) { return !(a == b); }
+inline bool operator<(const MortonKey &a, const MortonKey &b) { return MortonKey::PreorderLess(a, b); }
+
+} // namespace copc
+
+template <> struct std::hash<copc::MortonKey>
+{
+    std::size_t operator()(copc::MortonKey const &k) const noexcept
+    {
+        return static_cast<std::size_t>(copc::Internal::MixHash(k.Code()));
+    }
+};
+
+#endif // COPCLIB_HIERARCHY_MORTON_KEY_H_
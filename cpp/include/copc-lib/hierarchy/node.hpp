@@ -1,6 +1,7 @@
 #ifndef COPCLIB_HIERARCHY_NODE_H_
 #define COPCLIB_HIERARCHY_NODE_H_
 
+#include <memory>
 #include <sstream>
 #include <vector>
 
@@ -11,6 +12,7 @@ namespace copc
 {
 
 class Page;
+class NodeStats;
 class Node : public Entry
 {
   public:
@@ -19,6 +21,8 @@ class Node : public Entry
 
     bool operator==(const Node &rhs) { return IsEqual(rhs); }
     VoxelKey page_key{};
+    // Statistics of the node's points (see NodeStats), null if the file doesn't have them
+    std::shared_ptr<const NodeStats> stats;
 };
 
 } // namespace copc
@@ -29,6 +29,8 @@ class BaseIO
     std::shared_ptr<Internal::Hierarchy> hierarchy_;
     virtual std::vector<Entry> ReadPage(std::shared_ptr<Internal::PageInternal> page) = 0;
     void ReadAndParsePage(const std::shared_ptr<Internal::PageInternal> &page);
+    // Adds a page's entries to the hierarchy, as its subpages and nodes
+    void AddPageEntries(const std::shared_ptr<Internal::PageInternal> &page, const std::vector<Entry> &entries);
     // Recursively reads all subpages and nodes given a root and returns all the nodes that were loaded
     void LoadPageHierarchy(const std::shared_ptr<Internal::PageInternal> &page, std::vector<Node> &loaded_nodes);
 };
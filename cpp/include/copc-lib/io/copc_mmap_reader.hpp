@@ -0,0 +1,64 @@
+#ifndef COPCLIB_IO_COPC_MMAP_READER_H_
+#define COPCLIB_IO_COPC_MMAP_READER_H_
+
+#include <istream>
+#include <memory>
+#include <string>
+
+#include "copc-lib/io/copc_reader.hpp"
+
+namespace copc
+{
+namespace Internal
+{
+class MemoryStreamBuf;
+} // namespace Internal
+
+// Reader that maps the whole file into memory once, and serves hierarchy pages and node data
+// directly out of the mapping instead of seeking and reading through a stream.
+// Since there is no shared file cursor, a single MmapReader can be used by many threads at once.
+class MmapReader : public Reader
+{
+  public:
+    MmapReader(const std::string &file_path);
+
+    // Bring in the VoxelKey overload, which is hidden by the Node override below
+    using Reader::GetPointDataCompressed;
+
+    std::vector<char> GetPointDataCompressed(Node const &node) override;
+
+    void Close();
+
+    std::string FilePath() { return file_path_; }
+    // Size of the mapped file, in bytes
+    size_t FileSize() const { return size_; }
+
+    ~MmapReader();
+
+  protected:
+    std::vector<Entry> ReadPage(std::shared_ptr<Internal::PageInternal> page) override;
+    void ReadFileBytes(uint64_t offset, char *out, size_t size) override;
+    void ReadPointData(Node const &node, char *out, size_t out_size) override;
+
+  private:
+    bool is_open_{false};
+    std::string file_path_;
+
+    const char *data_{nullptr};
+    size_t size_{0};
+#ifdef _WIN32
+    void *file_handle_{nullptr};
+    void *mapping_handle_{nullptr};
+#endif
+
+    std::unique_ptr<Internal::MemoryStreamBuf> stream_buf_;
+    std::unique_ptr<std::istream> stream_;
+
+    void Map();
+    void Unmap();
+    // Throws if the range [offset, offset + size) isn't within the mapped file
+    void CheckRange(uint64_t offset, uint64_t size, const std::string &caller) const;
+};
+
+} // namespace copc
+#endif // COPCLIB_IO_COPC_MMAP_READER_H_
@@ -0,0 +1,53 @@
+#ifndef COPCLIB_IO_COPC_PREAD_READER_H_
+#define COPCLIB_IO_COPC_PREAD_READER_H_
+
+#include <fstream>
+#include <memory>
+#include <string>
+
+#include "copc-lib/io/copc_reader.hpp"
+
+namespace copc
+{
+
+// Reader that serves hierarchy pages and node data with positional reads (pread on POSIX,
+// ReadFile with an OVERLAPPED offset on Windows), so there is no shared file cursor.
+// A single PreadReader can be used by many threads at once, e.g. to decode different nodes in parallel.
+class PreadReader : public Reader
+{
+  public:
+    PreadReader(const std::string &file_path);
+
+    // Bring in the VoxelKey overload, which is hidden by the Node override below
+    using Reader::GetPointDataCompressed;
+
+    std::vector<char> GetPointDataCompressed(Node const &node) override;
+
+    void Close();
+
+    std::string FilePath() { return file_path_; }
+
+    ~PreadReader() { Close(); }
+
+  protected:
+    std::vector<Entry> ReadPage(std::shared_ptr<Internal::PageInternal> page) override;
+    void ReadFileBytes(uint64_t offset, char *out, size_t size) override;
+
+  private:
+    bool is_open_{false};
+    std::string file_path_;
+#ifdef _WIN32
+    void *file_handle_{nullptr};
+#else
+    int fd_{-1};
+#endif
+    // Only used to parse the header and VLRs on construction, and closed right after
+    std::unique_ptr<std::ifstream> init_stream_;
+    void CloseInitStream();
+
+    // Reads exactly `size` bytes starting at `offset` into `out`, without touching any shared cursor
+    void ReadAt(uint64_t offset, char *out, size_t size, const std::string &caller) const;
+};
+
+} // namespace copc
+#endif // COPCLIB_IO_COPC_PREAD_READER_H_
@@ -1,15 +1,24 @@
 #ifndef COPCLIB_IO_COPC_READER_H_
 #define COPCLIB_IO_COPC_READER_H_
 
+#include <deque>
+#include <functional>
+#include <future>
 #include <istream>
 #include <limits>
 #include <map>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 
 #include "copc-lib/copc/copc_config.hpp"
+#include "copc-lib/copc/node_stats.hpp"
+#include "copc-lib/copc/point_filter.hpp"
+#include "copc-lib/geometry/box.hpp"
 #include "copc-lib/hierarchy/key.hpp"
 #include "copc-lib/io/base_reader.hpp"
 #include "copc-lib/io/copc_base_io.hpp"
+#include "copc-lib/las/point_buffer.hpp"
 #include "copc-lib/las/points.hpp"
 #include "copc-lib/las/vlr.hpp"
 
@@ -17,24 +26,113 @@ namespace copc
 {
 namespace Internal
 {
+class NodeCache;
 class PageInternal;
+class ThreadPool;
 } // namespace Internal
 
+// Counters of a reader's decompressed node cache
+struct NodeCacheStats
+{
+    uint64_t hits{0};
+    uint64_t misses{0};
+    uint64_t evictions{0};
+    // Nodes and bytes of decompressed data currently cached
+    size_t node_count{0};
+    size_t bytes{0};
+    size_t max_bytes{0};
+};
+
+class Reader;
+
+// Pull-based cursor over the points of a spatial query, that yields the points of one node at a time
+// The query's nodes are found up front, but their points are only decoded as batches are requested, so memory use is
+// bounded by the nodes in flight rather than by the size of the query. With a prefetch > 0, up to that many of the
+// following nodes are decoded ahead on the reader's thread pool.
+// The reader must outlive the cursor.
+class PointCursor
+{
+  public:
+    PointCursor(const PointCursor &) = delete;
+    PointCursor &operator=(const PointCursor &) = delete;
+    PointCursor(PointCursor &&) = default;
+    // Waits on the nodes still being decoded, since they reference the reader
+    ~PointCursor();
+
+    // Moves the points of the next node that has points in the query into `out`
+    // Returns false, leaving `out` untouched, once every node has been read
+    bool Next(las::Points &out);
+
+    // Node that the last batch came from
+    const Node &CurrentNode() const { return current_node_; }
+    const las::LasHeader &LasHeader() const { return *header_; }
+    // Number of nodes in the query, and how many of them have been read so far
+    size_t NodeCount() const { return nodes_.size(); }
+    size_t NodesRead() const { return next_read_; }
+
+  private:
+    friend class Reader;
+    PointCursor(Reader *reader, std::vector<Node> nodes, const Box &box, unsigned int prefetch);
+
+    // Decodes a node's points, keeping only those within `box` if the node crosses it
+    // Prefetched nodes don't reference the cursor, so it can be moved while they are decoded
+    static las::Points DecodeNode(Reader *reader, const std::shared_ptr<const las::LasHeader> &header, const Box &box,
+                                  const Node &node);
+    // Queues nodes on pool_ until prefetch_ of them are in flight
+    void Prefetch();
+
+    Reader *reader_;
+    std::shared_ptr<const las::LasHeader> header_;
+    std::vector<Node> nodes_;
+    Box box_;
+    unsigned int prefetch_;
+    std::shared_ptr<Internal::ThreadPool> pool_;
+    // Nodes being decoded on pool_, in the order of nodes_ starting at next_read_
+    std::deque<std::future<las::Points>> pending_;
+    size_t next_read_{0};
+    size_t next_queued_{0};
+    Node current_node_;
+};
+
 class Reader : public BaseIO, public BaseReader
 {
   public:
     Reader(std::istream *in_stream) : BaseReader(in_stream) { InitCopcReader(); }
 
+    // Find a node object given a key, with its statistics if the file has them (see NodeStats)
+    Node FindNode(VoxelKey key);
+
     // Reads the node's data into an uncompressed byte array
     // Node needs to be valid for this function, it will error
     std::vector<char> GetPointData(Node const &node);
+    // Decompresses the node's data straight into `out`, which must hold at least PointDataSize(node) bytes
+    void GetPointData(Node const &node, char *out, size_t out_size);
+    // Same as above, but resizes `out` to fit, so one vector can be reused across many nodes without reallocating
+    void GetPointData(Node const &node, std::vector<char> &out);
+    // Number of bytes of the node's uncompressed data
+    size_t PointDataSize(Node const &node) const;
     // VoxelKey can be invalid, function will return empty arr
     std::vector<char> GetPointData(VoxelKey const &key);
     // Reads the node's data into Point objects
     las::Points GetPoints(Node const &node);
     las::Points GetPoints(VoxelKey const &key);
+    // Decodes many nodes concurrently on an internal thread pool, results are in the same order as `nodes`
+    // A num_threads of 0 uses one thread per hardware core
+    std::vector<las::Points> GetPoints(const std::vector<Node> &nodes, unsigned int num_threads = 0);
+    // Same as above, but hands each node's points to `callback` as soon as they are decoded (in completion order)
+    // The callback runs on the calling thread, so it may call back into the reader, including its batch functions
+    void GetPoints(const std::vector<Node> &nodes, const std::function<void(const Node &, las::Points &)> &callback,
+                   unsigned int num_threads = 0);
+    // Reads the node's data into a columnar PointBuffer
+    // Only the dimensions in the `dimensions` mask (see las::Dimension) are unpacked, the other columns stay empty
+    las::PointBuffer GetPointBuffer(Node const &node, uint32_t dimensions = las::Dimension::DIM_ALL);
+    las::PointBuffer GetPointBuffer(VoxelKey const &key, uint32_t dimensions = las::Dimension::DIM_ALL);
+    // Decodes many nodes concurrently into PointBuffers, results are in the same order as `nodes`
+    std::vector<las::PointBuffer> GetPointBuffers(const std::vector<Node> &nodes,
+                                                  uint32_t dimensions = las::Dimension::DIM_ALL,
+                                                  unsigned int num_threads = 0);
     // Reads node data without decompressing
-    std::vector<char> GetPointDataCompressed(Node const &node);
+    virtual std::vector<char> GetPointDataCompressed(Node const &node);
     std::vector<char> GetPointDataCompressed(VoxelKey const &key);
 
     // Return all children of a page with a given key
@@ -46,8 +144,13 @@ class Reader : public BaseIO, public BaseReader
     // Return all keys of pages in copc hierarchy
     std::vector<VoxelKey> GetPageList();
 
+    // Reads the whole hierarchy EVLR in a single read, and parses every page that isn't loaded yet from memory
+    // Each level of the page tree is parsed on `num_threads` threads (0 uses one thread per hardware core)
+    // GetAllNodes does this on its own, other queries keep loading only the pages they need
+    void LoadHierarchy(unsigned int num_threads = 1);
+
     // Helper function to get all points from the root
-    las::Points GetAllPoints(double resolution = 0);
+    las::Points GetAllPoints(double resolution = 0, unsigned int num_threads = 0);
 
     // Resolution query functions
     // The resulting resolution may not be exactly this value: the minimum possible resolution that is at least as
@@ -62,12 +165,38 @@ class Reader : public BaseIO, public BaseReader
     // Definitions taken from https://shapely.readthedocs.io/en/stable/manual.html#binary-predicates
     std::vector<Node> GetNodesWithinBox(const Box &box, double resolution = 0);
     std::vector<Node> GetNodesIntersectBox(const Box &box, double resolution = 0);
-    las::Points GetPointsWithinBox(const Box &box, double resolution = 0);
+    las::Points GetPointsWithinBox(const Box &box, double resolution = 0, unsigned int num_threads = 0);
+    // Same query as GetPointsWithinBox, but streams the points one node at a time instead of returning them all at
+    // once, see PointCursor. Up to `prefetch` nodes are decoded ahead of the one being read.
+    PointCursor QueryPointsWithinBox(const Box &box, double resolution = 0, unsigned int prefetch = 0);
     bool ValidateSpatialBounds(bool verbose = false);
+
+    // Attribute query functions
+    // Node statistics come from the file's node statistics EVLR (see NodeStats, and Writer::EnableNodeStats), which
+    // is read the first time they are needed. The nodes returned by the reader's queries carry them too.
+    bool HasNodeStats();
+    // Returns false, leaving `out` untouched, if the file has no statistics for the node
+    bool GetNodeStats(const VoxelKey &key, NodeStats &out);
+    // Nodes within `resolution` that intersect `box`, except those whose statistics show that none of their points
+    // pass `filter`. Nodes without statistics are always kept.
+    std::vector<Node> GetNodesWithFilter(const PointFilter &filter, const Box &box = Box::MaxBox(),
+                                         double resolution = 0);
+    // Points within `box` that pass `filter`, only the nodes from GetNodesWithFilter are decoded
+    // The buffer holds the `dimensions`, plus those needed to test the filter and the box
+    las::PointBuffer GetPointsWithFilter(const PointFilter &filter, const Box &box = Box::MaxBox(),
+                                         double resolution = 0, uint32_t dimensions = las::Dimension::DIM_ALL,
+                                         unsigned int num_threads = 0);
     // TODO: Add a function to validate extents.
 
     copc::CopcConfig CopcConfig() { return config_; }
 
+    // Keeps up to `max_bytes` of decompressed node data in memory, so nodes that are requested again (e.g. the upper
+    // levels of the octree) aren't read and decompressed again. The least recently used nodes are evicted first.
+    // A max_bytes of 0 disables the cache. Enabling it again starts from an empty cache.
+    void EnableNodeCache(size_t max_bytes);
+    void ClearNodeCache();
+    NodeCacheStats GetNodeCacheStats() const;
+
   protected:
     Reader() = default;
     void InitCopcReader();
@@ -79,6 +208,55 @@ class Reader : public BaseIO, public BaseReader
     CopcExtents ReadCopcExtentsVlr(std::map<uint64_t, las::VlrHeader> &vlrs, const las::EbVlr &eb_vlr) const;
 
     std::vector<Entry> ReadPage(std::shared_ptr<Internal::PageInternal> page) override;
+
+    // Reads `size` bytes of the file, starting at `offset`
+    virtual void ReadFileBytes(uint64_t offset, char *out, size_t size);
+    // Parses the entries of a page from a buffer holding its `byte_size` bytes
+    static std::vector<Entry> ParsePage(const char *page_data, int32_t byte_size);
+
+    // Reads and decompresses the node's data into `out`, bypassing the node cache
+    // The compressed bytes are read with ReadFileBytes, readers that can avoid that copy override this
+    virtual void ReadPointData(Node const &node, char *out, size_t out_size);
+    // Decompresses a node's chunk into `out`
+    void DecompressNode(const Node &node, const char *compressed_data, size_t compressed_size, char *out,
+                        size_t out_size) const;
+
+    // Guards in_stream_, since seeking and reading through it isn't thread-safe
+    std::mutex stream_mutex_;
+
+  private:
+    friend class PointCursor;
+
+    std::mutex thread_pool_mutex_;
+    std::shared_ptr<Internal::ThreadPool> thread_pool_;
+
+    // Returns the shared decoding pool, which has at least as many workers as the hardware supports and grows if a
+    // batch asks for more. Batches cap their own parallelism with ThreadPool::ForEach
+    std::shared_ptr<Internal::ThreadPool> GetThreadPool(unsigned int num_threads = 0);
+    // Runs `decode` on each node on at most num_threads workers, results are in the same order as `nodes`
+    template <typename T, typename F>
+    std::vector<T> DecodeNodes(const std::vector<Node> &nodes, unsigned int num_threads, const F &decode);
+
+    mutable std::mutex node_cache_mutex_;
+    std::shared_ptr<Internal::NodeCache> node_cache_;
+
+    std::shared_ptr<Internal::NodeCache> GetNodeCache() const;
+
+    std::mutex node_stats_mutex_;
+    bool node_stats_loaded_{false};
+    std::shared_ptr<const std::unordered_map<VoxelKey, NodeStats>> node_stats_;
+
+    // Reads the node statistics EVLR on the first call, the map is empty if the file doesn't have one
+    std::shared_ptr<const std::unordered_map<VoxelKey, NodeStats>> LoadNodeStats();
+    // Sets the node's stats, if the file has them
+    void AttachNodeStats(Node &node);
+    // Returns the node's decompressed data, from the node cache if it's enabled and holds the node
+    std::shared_ptr<const std::vector<char>> LoadPointData(Node const &node);
+
+    // Walks the octree down from `key`, only descending into (and loading the pages of) keys that intersect `box`
+    void CollectNodesIntersectBox(const VoxelKey &key, const Box &box, int32_t max_depth, std::vector<Node> &out);
+    // Depth to stop a query at for a given resolution, without having to load the whole hierarchy
+    int32_t GetQueryDepthAtResolution(double resolution) const;
 };
 
 class FileReader : public Reader
@@ -2,16 +2,19 @@
 #define COPCLIB_IO_COPC_WRITER_H_
 
 #include <array>
+#include <future>
 #include <optional>
 #include <ostream>
 #include <stdexcept>
 #include <string>
 
 #include "copc-lib/copc/copc_config.hpp"
+#include "copc-lib/copc/extents_accumulator.hpp"
 #include "copc-lib/geometry/box.hpp"
 #include "copc-lib/io/copc_base_io.hpp"
 #include "copc-lib/io/laz_base_writer.hpp"
 #include "copc-lib/las/header.hpp"
+#include "copc-lib/las/point_buffer.hpp"
 #include "copc-lib/las/points.hpp"
 #include "copc-lib/las/utils.hpp"
 
@@ -40,16 +43,52 @@ class Writer : public BaseIO
 
     // Adds a node to a given page
     Node AddNode(const VoxelKey &key, const las::Points &points, const VoxelKey &page_key = VoxelKey::RootKey());
+    Node AddNode(const VoxelKey &key, const las::PointBuffer &points, const VoxelKey &page_key = VoxelKey::RootKey());
     Node AddNodeCompressed(const VoxelKey &key, std::vector<char> const &compressed_data, int32_t point_count,
                            const VoxelKey &page_key = VoxelKey::RootKey());
     Node AddNode(const VoxelKey &key, std::vector<char> const &uncompressed_data,
                  const VoxelKey &page_key = VoxelKey::RootKey());
 
+    // Queues a node to be compressed and written in the background, and returns right away
+    // The future holds the written node (with its offset and byte size), or rethrows the error that prevented
+    // writing it. Without EnableParallelCompression, the async nodes are compressed with the default settings, and
+    // AddNode still writes its node before returning, once the queued ones are written.
+    std::future<Node> AddNodeAsync(const VoxelKey &key, const las::Points &points,
+                                   const VoxelKey &page_key = VoxelKey::RootKey());
+    std::future<Node> AddNodeAsync(const VoxelKey &key, const las::PointBuffer &points,
+                                   const VoxelKey &page_key = VoxelKey::RootKey());
+
     void ChangeNodePage(const VoxelKey &node_key, const VoxelKey &new_page_key);
 
+    static constexpr size_t DEFAULT_MAX_BYTES_IN_FLIGHT = 256 * 1024 * 1024;
+
+    // Compresses nodes on a pool of `num_threads` threads (0 uses one per hardware core), while a single thread
+    // writes them to the file in the order they were added, so the output is the same as without it.
+    // Once enabled, AddNode returns as soon as the node is queued, and the returned Node's offset and byte size
+    // are not set yet: they're recorded in the hierarchy once the node is written (see Flush and FindNode).
+    // Adding a node blocks while the queued nodes hold more than `max_bytes_in_flight` bytes of point data.
+    void EnableParallelCompression(unsigned int num_threads = 0,
+                                   size_t max_bytes_in_flight = DEFAULT_MAX_BYTES_IN_FLIGHT);
+    // Blocks until every queued node has been written, and rethrows the first error that occurred while writing
+    void Flush();
+
+    // Computes the NodeStats of the nodes added from now on, and writes them to the node statistics EVLR on Close,
+    // so readers can skip nodes with attribute filters (see Reader::GetNodesWithFilter).
+    // Compressed nodes are decompressed to compute them.
+    void EnableNodeStats(bool enable = true);
+
+    // Accumulates the min/max (and mean/variance, for extended stats) of every point field as nodes are added, on
+    // the compression workers when parallel compression is enabled, and sets the LasHeader's bounds and the
+    // CopcExtents from them on Close, overwriting the ones in the config. Extra byte extents are left as they are.
+    // Compressed nodes are decompressed to do so.
+    void EnableAutoExtents(bool enable = true);
+    // Extents of the nodes added so far, once they've been analyzed (see Flush)
+    ExtentsAccumulator AccumulatedExtents();
+
     std::shared_ptr<CopcConfigWriter> CopcConfig() { return config_; }
 
-    ~Writer() { Close(); }
+    // Closes the file if needed, an error from a node written in the background is dropped, call Close to get it
+    ~Writer();
 
   protected:
     Writer() = default;
@@ -57,11 +96,18 @@ class Writer : public BaseIO
     std::shared_ptr<CopcConfigWriter> config_;
 
     std::shared_ptr<Internal::WriterInternal> writer_;
+    // Whether EnableParallelCompression was called, which AddNodeAsync alone doesn't do
+    bool parallel_compression_{false};
 
     bool PageExists(const VoxelKey &key);
 
     Node DoAddNode(const VoxelKey &key, const std::vector<char> &in, int32_t point_count, bool compressed_data,
                    const VoxelKey &page_key);
+    Node QueueNode(const VoxelKey &key, std::vector<char> in, int32_t point_count, bool compressed_data,
+                   const VoxelKey &page_key, std::promise<Node> written = std::promise<Node>());
+    std::future<Node> DoAddNodeAsync(const VoxelKey &key, std::vector<char> uncompressed_data,
+                                     const VoxelKey &page_key);
+    Node InsertNode(const std::shared_ptr<Node> &node);
     std::vector<Entry> ReadPage(std::shared_ptr<Internal::PageInternal> page) override
     {
         throw std::runtime_error("No pages should be unloaded!");
@@ -89,7 +135,7 @@ class FileWriter : public Writer, laz::BaseFileWriter
     }
 
     void Close() override;
-    ~FileWriter() { Close(); }
+    ~FileWriter();
 
     std::string FilePath() { return file_path_; }
 };
@@ -1,10 +1,22 @@
 #ifndef COPCLIB_IO_COPC_WRITER_INTERNAL_H_
 #define COPCLIB_IO_COPC_WRITER_INTERNAL_H_
 
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <future>
+#include <memory>
+#include <mutex>
 #include <ostream>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
 #include "copc-lib/copc/copc_config.hpp"
+#include "copc-lib/copc/node_stats.hpp"
 #include "copc-lib/io/copc_base_io.hpp"
+#include "copc-lib/io/internal/thread_pool.hpp"
 #include "copc-lib/io/laz_base_writer.hpp"
 #include "copc-lib/las/header.hpp"
 
@@ -19,15 +31,77 @@ class WriterInternal : laz::BaseWriter
 
     // Writes the header and COPC vlrs
     void Close() override;
-    // Call close on destructor if needed
-    ~WriterInternal() { Close(); }
+    // Call close on destructor if needed, a pipeline error is only rethrown by an explicit Close or Flush
+    ~WriterInternal();
 
     // Writes a chunk to the laz file
     Entry WriteNode(const std::vector<char> &in, int32_t point_count, bool compressed);
 
+    // Starts compressing nodes on a pool of `num_threads` threads, with a single committer thread that writes
+    // them to the stream in the order they were queued
+    // QueueNode blocks while the queued nodes hold more than `max_bytes_in_flight` bytes of input data
+    void StartPipeline(size_t num_threads, size_t max_bytes_in_flight);
+    bool Pipelined() const { return compress_pool_ != nullptr; }
+    // Queues a node for compression and writing, the node's offset and byte size are set once it's written
+    // `written` then receives a copy of the node, or the error that prevented writing it
+    void QueueNode(const std::shared_ptr<Node> &node, std::vector<char> in, bool compressed,
+                   std::promise<Node> written = std::promise<Node>());
+    // Blocks until every queued node has been written, and rethrows the first error that occurred
+    void Flush();
+
+    // Computes the statistics of the nodes written from now on, which Close writes to the node statistics EVLR
+    void EnableNodeStats(bool enable) { node_stats_enabled_ = enable; }
+    bool NodeStatsEnabled() const { return node_stats_enabled_; }
+    using BaseWriter::AccumulatedExtents;
+    using BaseWriter::EnableAutoExtents;
+    // Whether nodes are decoded as they're added, to compute their stats or accumulate the extents
+    bool AnalyzesNodes() const { return node_stats_enabled_ || auto_extents_; }
+    // Decodes a node's point data (decompressing it first if needed), records its stats if they're enabled and
+    // accumulates its extents if auto extents are enabled. Returns the stats, or null if they're disabled.
+    // Thread-safe, so the compression workers can analyze nodes in parallel
+    std::shared_ptr<const NodeStats> AnalyzeNode(const VoxelKey &key, const std::vector<char> &in, bool compressed,
+                                                 int32_t point_count);
+
   private:
     std::shared_ptr<Hierarchy> hierarchy_;
 
+    struct PendingNode
+    {
+        std::shared_ptr<Node> node;
+        std::future<std::vector<char>> compressed_data;
+        // Size of the input data, counted against the bytes in flight
+        size_t byte_size{0};
+        std::promise<Node> written;
+        // Set by the worker that analyzes the node, and recorded on the node once it's written
+        std::shared_ptr<std::shared_ptr<const NodeStats>> stats;
+    };
+
+    std::unique_ptr<ThreadPool> compress_pool_;
+    std::thread committer_;
+    std::deque<PendingNode> pending_nodes_;
+    // Number of nodes queued but not written yet, and the size of their input data
+    size_t in_flight_{0};
+    size_t bytes_in_flight_{0};
+    // Input bytes past which QueueNode blocks, so memory stays bounded
+    size_t max_bytes_in_flight_{0};
+    bool stopping_{false};
+    std::exception_ptr pipeline_error_;
+    std::mutex pipeline_mutex_;
+    // Signaled when a node is queued, or when the pipeline stops
+    std::condition_variable queued_cv_;
+    // Signaled when a node has been written
+    std::condition_variable committed_cv_;
+
+    void CommitLoop();
+    void StopPipeline();
+
+    std::atomic<bool> node_stats_enabled_{false};
+    std::mutex node_stats_mutex_;
+    std::unordered_map<VoxelKey, NodeStats> node_stats_;
+
+    // Writes the node statistics EVLR, if any node has stats
+    void WriteNodeStats();
+
     std::shared_ptr<CopcConfigWriter> GetConfig() const
     {
         return std::dynamic_pointer_cast<CopcConfigWriter>(config_);
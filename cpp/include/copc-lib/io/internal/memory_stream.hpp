@@ -0,0 +1,51 @@
+#ifndef COPCLIB_IO_MEMORY_STREAM_H_
+#define COPCLIB_IO_MEMORY_STREAM_H_
+
+#include <cstddef>
+#include <istream>
+#include <streambuf>
+
+namespace copc::Internal
+{
+// Read-only, seekable streambuf over an existing memory region.
+// The region is not copied or owned, so it must outlive the buffer.
+class MemoryStreamBuf : public std::streambuf
+{
+  public:
+    MemoryStreamBuf(const char *data, size_t size)
+    {
+        char *begin = const_cast<char *>(data);
+        setg(begin, begin, begin + size);
+    }
+
+  protected:
+    pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override
+    {
+        if (!(which & std::ios_base::in))
+            return pos_type(off_type(-1));
+
+        off_type base;
+        if (dir == std::ios_base::beg)
+            base = 0;
+        else if (dir == std::ios_base::cur)
+            base = gptr() - eback();
+        else
+            base = egptr() - eback();
+
+        off_type pos = base + off;
+        if (pos < 0 || pos > egptr() - eback())
+            return pos_type(off_type(-1));
+
+        setg(eback(), eback() + pos, egptr());
+        return pos_type(pos);
+    }
+
+    pos_type seekpos(pos_type pos, std::ios_base::openmode which) override
+    {
+        return seekoff(off_type(pos), std::ios_base::beg, which);
+    }
+};
+
+} // namespace copc::Internal
+
+#endif // COPCLIB_IO_MEMORY_STREAM_H_
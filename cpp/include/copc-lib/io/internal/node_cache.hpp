@@ -0,0 +1,133 @@
+#ifndef COPCLIB_IO_NODE_CACHE_H_
+#define COPCLIB_IO_NODE_CACHE_H_
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "copc-lib/hierarchy/key.hpp"
+
+namespace copc::Internal
+{
+// Thread-safe LRU cache of decompressed node data, bounded by the total number of bytes it holds
+// Entries are shared, so data handed out stays valid after it's evicted
+class NodeCache
+{
+  public:
+    using Data = std::shared_ptr<const std::vector<char>>;
+
+    NodeCache(size_t max_bytes) : max_bytes_(max_bytes) {}
+
+    NodeCache(const NodeCache &) = delete;
+    NodeCache &operator=(const NodeCache &) = delete;
+
+    // Returns the node's data and marks it as most recently used, or nullptr if it isn't cached
+    Data Get(const VoxelKey &key)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = entries_.find(key);
+        if (it == entries_.end())
+        {
+            misses_++;
+            return nullptr;
+        }
+        hits_++;
+        lru_.splice(lru_.begin(), lru_, it->second.lru_it);
+        return it->second.data;
+    }
+
+    // Caches the node's data, evicting the least recently used nodes until it fits
+    // Data larger than the whole budget isn't cached
+    void Put(const VoxelKey &key, const Data &data)
+    {
+        size_t size = data->size();
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (size > max_bytes_)
+            return;
+
+        auto it = entries_.find(key);
+        if (it != entries_.end())
+        {
+            // Another thread decoded the same node in the meantime
+            lru_.splice(lru_.begin(), lru_, it->second.lru_it);
+            return;
+        }
+
+        while (bytes_ + size > max_bytes_)
+            EvictLast();
+
+        lru_.push_front(key);
+        entries_.emplace(key, Entry{data, lru_.begin()});
+        bytes_ += size;
+    }
+
+    void Clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        entries_.clear();
+        lru_.clear();
+        bytes_ = 0;
+    }
+
+    uint64_t Hits() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return hits_;
+    }
+    uint64_t Misses() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return misses_;
+    }
+    uint64_t Evictions() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return evictions_;
+    }
+    // Bytes of node data currently held
+    size_t Bytes() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return bytes_;
+    }
+    size_t NodeCount() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return entries_.size();
+    }
+    size_t MaxBytes() const { return max_bytes_; }
+
+  private:
+    struct Entry
+    {
+        Data data;
+        std::list<VoxelKey>::iterator lru_it;
+    };
+
+    void EvictLast()
+    {
+        auto it = entries_.find(lru_.back());
+        bytes_ -= it->second.data->size();
+        entries_.erase(it);
+        lru_.pop_back();
+        evictions_++;
+    }
+
+    const size_t max_bytes_;
+    size_t bytes_{0};
+    uint64_t hits_{0};
+    uint64_t misses_{0};
+    uint64_t evictions_{0};
+    // Most recently used key first
+    std::list<VoxelKey> lru_;
+    std::unordered_map<VoxelKey, Entry> entries_;
+    mutable std::mutex mutex_;
+};
+
+} // namespace copc::Internal
+
+#endif // COPCLIB_IO_NODE_CACHE_H_
@@ -0,0 +1,272 @@
+#ifndef COPCLIB_IO_THREAD_POOL_H_
+#define COPCLIB_IO_THREAD_POOL_H_
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace copc::Internal
+{
+// Pool of worker threads that run submitted tasks in FIFO order, it can grow but never shrinks
+class ThreadPool
+{
+  public:
+    ThreadPool(size_t num_threads)
+    {
+        if (num_threads == 0)
+            num_threads = 1;
+        workers_.reserve(num_threads);
+        for (size_t i = 0; i < num_threads; i++)
+            workers_.emplace_back([this] { WorkerLoop(); });
+    }
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    // Finishes all queued tasks before joining the workers
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        cv_.notify_all();
+        for (auto &worker : workers_)
+            worker.join();
+    }
+
+    size_t Size() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return workers_.size();
+    }
+
+    // Adds workers until the pool has at least num_threads of them
+    void Grow(size_t num_threads)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        while (workers_.size() < num_threads)
+            workers_.emplace_back([this] { WorkerLoop(); });
+    }
+
+    // Queues a task, the returned future holds its result or rethrows its exception
+    template <typename F> std::future<std::invoke_result_t<F>> Submit(F &&task)
+    {
+        using R = std::invoke_result_t<F>;
+        auto packaged = std::make_shared<std::packaged_task<R()>>(std::forward<F>(task));
+        std::future<R> result = packaged->get_future();
+        Enqueue([packaged] { (*packaged)(); });
+        return result;
+    }
+
+    // Calls task(i) for each i in [0, count) on at most max_tasks threads at once, the calling thread included, so
+    // that a batch can use fewer threads than the pool has. Returns once the whole batch ran, and then rethrows the
+    // first exception a task threw
+    template <typename F> void ForEach(size_t count, size_t max_tasks, const F &task)
+    {
+        ForEachCompleted(
+            count, max_tasks,
+            [&task](size_t i)
+            {
+                task(i);
+                return true;
+            },
+            [](size_t, bool) {});
+    }
+
+    // Calls produce(i) for each i in [0, count) on at most max_tasks threads at once, the calling thread included,
+    // and consume(i, result) on the calling thread as results complete. At most max_tasks results are produced but
+    // not yet consumed at any time, so a slow consumer holds back the producers
+    // The calling thread runs the items no worker has started, so nested batches can't deadlock waiting on workers
+    // that are busy with their parent batch. Called from one of the pool's workers, every item runs inline
+    template <typename P, typename C>
+    void ForEachCompleted(size_t count, size_t max_tasks, const P &produce, const C &consume)
+    {
+        using R = std::invoke_result_t<P, size_t>;
+        if (CurrentPool() == this)
+            max_tasks = 1;
+        if (max_tasks <= 1)
+        {
+            for (size_t i = 0; i < count; i++)
+            {
+                R result = produce(i);
+                consume(i, result);
+            }
+            return;
+        }
+
+        // Items are claimed under the batch's mutex, by a worker or by the calling thread, whoever comes first
+        struct Item
+        {
+            bool claimed{false};
+            std::optional<R> result;
+            std::exception_ptr error;
+        };
+        struct Batch
+        {
+            std::mutex mutex;
+            std::condition_variable cv;
+            std::vector<Item> items;
+            std::queue<size_t> completed;
+            size_t running{0};
+        };
+        auto batch = std::make_shared<Batch>();
+        batch->items.resize(count);
+
+        auto run = [&produce](Item &item, size_t i)
+        {
+            try
+            {
+                item.result.emplace(produce(i));
+            }
+            catch (...)
+            {
+                item.error = std::current_exception();
+            }
+        };
+
+        // A worker only touches `run` between claiming an item and reporting it as completed, and the calling
+        // thread waits for every claimed item before returning
+        auto finish = [&batch]
+        {
+            std::unique_lock<std::mutex> lock(batch->mutex);
+            for (auto &item : batch->items)
+                item.claimed = true;
+            batch->cv.wait(lock, [&batch] { return batch->running == 0; });
+        };
+
+        size_t queued = 0;
+        size_t consumed = 0;
+        // Items before this one have all been claimed
+        size_t first_unclaimed = 0;
+        try
+        {
+            while (consumed < count)
+            {
+                // Keep at most max_tasks items in flight
+                for (; queued < count && queued < consumed + max_tasks; queued++)
+                {
+                    Enqueue(
+                        [batch, &run, i = queued]
+                        {
+                            {
+                                std::lock_guard<std::mutex> lock(batch->mutex);
+                                if (batch->items[i].claimed)
+                                    return;
+                                batch->items[i].claimed = true;
+                                batch->running++;
+                            }
+                            run(batch->items[i], i);
+                            {
+                                std::lock_guard<std::mutex> lock(batch->mutex);
+                                batch->completed.push(i);
+                                batch->running--;
+                            }
+                            batch->cv.notify_all();
+                        });
+                }
+
+                // Take a completed item, or run one that no worker has started yet, or wait for a worker
+                size_t i = count;
+                bool run_here = false;
+                {
+                    std::unique_lock<std::mutex> lock(batch->mutex);
+                    while (true)
+                    {
+                        if (!batch->completed.empty())
+                        {
+                            i = batch->completed.front();
+                            batch->completed.pop();
+                            break;
+                        }
+                        while (first_unclaimed < queued && batch->items[first_unclaimed].claimed)
+                            first_unclaimed++;
+                        if (first_unclaimed < queued)
+                        {
+                            i = first_unclaimed;
+                            batch->items[i].claimed = true;
+                            run_here = true;
+                            break;
+                        }
+                        batch->cv.wait(lock);
+                    }
+                }
+                if (run_here)
+                    run(batch->items[i], i);
+
+                auto &item = batch->items[i];
+                consumed++;
+                if (item.error)
+                    std::rethrow_exception(item.error);
+                consume(i, *item.result);
+                item.result.reset();
+            }
+        }
+        catch (...)
+        {
+            finish();
+            throw;
+        }
+        finish();
+    }
+
+    // Number of threads to use when the caller asks for 0 (i.e. "as many as the hardware supports")
+    static size_t DefaultThreadCount()
+    {
+        auto count = std::thread::hardware_concurrency();
+        return count == 0 ? 1 : count;
+    }
+
+  private:
+    // The pool whose worker is running on this thread, if any
+    static const ThreadPool *&CurrentPool()
+    {
+        thread_local const ThreadPool *pool = nullptr;
+        return pool;
+    }
+
+    void Enqueue(std::function<void()> task)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            tasks_.emplace(std::move(task));
+        }
+        cv_.notify_one();
+    }
+
+    void WorkerLoop()
+    {
+        CurrentPool() = this;
+        while (true)
+        {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cv_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+                if (tasks_.empty())
+                    return;
+                task = std::move(tasks_.front());
+                tasks_.pop();
+            }
+            task();
+        }
+    }
+
+    std::vector<std::thread> workers_;
+    std::queue<std::function<void()>> tasks_;
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    bool stopping_{false};
+};
+
+} // namespace copc::Internal
+
+#endif // COPCLIB_IO_THREAD_POOL_H_
@@ -2,7 +2,9 @@
 #define COPCLIB_IO_LAZ_BASE_WRITER_H_
 
 #include <array>
+#include <atomic>
 #include <iterator>
+#include <mutex>
 #include <optional>
 #include <ostream>
 #include <stdexcept>
@@ -10,6 +12,7 @@
 #include <utility>
 
 #include "copc-lib/copc/copc_config.hpp"
+#include "copc-lib/copc/extents_accumulator.hpp"
 #include "copc-lib/geometry/vector3.hpp"
 #include "copc-lib/las/header.hpp"
 #include "copc-lib/las/laz_config.hpp"
@@ -43,7 +46,21 @@ class BaseWriter
     virtual void Close();
     ~BaseWriter() { Close(); }
 
+    // Accumulates the extents of the points written from now on, which Close sets in the header, so callers don't
+    // have to compute them. Compressed data is decompressed to do so.
+    void EnableAutoExtents(bool enable = true) { auto_extents_ = enable; }
+    bool AutoExtentsEnabled() const { return auto_extents_; }
+    // Extents of the points accumulated so far
+    ExtentsAccumulator AccumulatedExtents();
+
   protected:
+    // Thread-safe, the expensive part runs outside of the lock so workers can accumulate in parallel
+    void AccumulateExtents(const las::PointBuffer &points);
+
+    std::atomic<bool> auto_extents_{false};
+    std::mutex extents_mutex_;
+    ExtentsAccumulator extents_;
+
     static const uint32_t VARIABLE_CHUNK_SIZE = std::numeric_limits<uint32_t>::max();
 
     bool open_{};
@@ -29,6 +29,10 @@ class LazWriter : public BaseWriter
     void WritePoints(const las::Points &points);
     void WritePointsCompressed(std::vector<char> const &compressed_data, int32_t point_count);
 
+    // Sets the header's bounds if auto extents are enabled (see EnableAutoExtents), and writes the file out
+    void Close() override;
+    ~LazWriter() { Close(); }
+
     std::shared_ptr<las::LazConfigWriter> LazConfig()
     {
         return std::dynamic_pointer_cast<las::LazConfigWriter>(config_);
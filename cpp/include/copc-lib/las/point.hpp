@@ -239,6 +239,11 @@ class Point
     static std::shared_ptr<Point> Unpack(std::istream &in_stream, const int8_t &point_format_id, const Vector3 &scale,
                                          const Vector3 &offset, const uint16_t &eb_byte_size);
     void Pack(std::ostream &out_stream, const Vector3 &scale, const Vector3 &offset) const;
+    // Raw buffer versions, which read/write one fixed-layout point record at `in`/`out`
+    // The buffer must hold at least PointRecordLength() bytes
+    static std::shared_ptr<Point> Unpack(const char *in, const int8_t &point_format_id, const Vector3 &scale,
+                                         const Vector3 &offset, const uint16_t &eb_byte_size);
+    void Pack(char *out, const Vector3 &scale, const Vector3 &offset) const;
     void ToPointFormat(const int8_t &point_format_id);
 
   protected:
@@ -0,0 +1,175 @@
+#ifndef COPCLIB_LAS_POINT_BUFFER_H_
+#define COPCLIB_LAS_POINT_BUFFER_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "copc-lib/geometry/box.hpp"
+#include "copc-lib/geometry/vector3.hpp"
+#include "copc-lib/las/header.hpp"
+#include "copc-lib/las/points.hpp"
+
+namespace copc::las
+{
+// Bit mask of the dimensions (columns) a PointBuffer holds
+// Prefixed, since names like RGB collide with macros from the Windows headers
+enum Dimension : uint32_t
+{
+    DIM_XYZ = 1 << 0,
+    DIM_INTENSITY = 1 << 1,
+    DIM_RETURNS = 1 << 2,
+    DIM_FLAGS = 1 << 3,
+    DIM_CLASSIFICATION = 1 << 4,
+    DIM_USER_DATA = 1 << 5,
+    DIM_SCAN_ANGLE = 1 << 6,
+    DIM_POINT_SOURCE_ID = 1 << 7,
+    DIM_GPS_TIME = 1 << 8,
+    DIM_RGB = 1 << 9,
+    DIM_NIR = 1 << 10,
+    DIM_EXTRA_BYTES = 1 << 11,
+    DIM_ALL = (1 << 12) - 1
+};
+
+// The PointBuffer class stores points column by column (structure-of-arrays), in contiguous vectors.
+// It holds the same data as Points, but without a heap allocation per point, which makes it much cheaper
+// to decode into and to scan over large amounts of points.
+// Only the point formats allowed by COPC (6-8) are supported.
+// A PointBuffer can hold a subset of the dimensions, given as a Dimension mask, in which case the other columns
+// stay empty. Dimensions that the point format doesn't have (e.g. RGB for format 6) are never held.
+class PointBuffer
+{
+  public:
+    PointBuffer(const int8_t &point_format_id, const uint16_t &eb_byte_size = 0,
+                const uint32_t &dimensions = Dimension::DIM_ALL);
+    PointBuffer(const LasHeader &header, const uint32_t &dimensions = Dimension::DIM_ALL);
+    // Will create a PointBuffer object from a Points object
+    PointBuffer(const Points &points);
+
+    // Getters
+    int8_t PointFormatId() const { return point_format_id_; }
+    uint32_t PointRecordLength() const { return point_record_length_; }
+    uint16_t EbByteSize() const { return eb_byte_size_; }
+    bool HasRgb() const { return has_rgb_; }
+    bool HasNir() const { return has_nir_; }
+    uint32_t Dimensions() const { return dimensions_; }
+    bool HasDimension(const Dimension &dimension) const { return (dimensions_ & dimension) != 0; }
+    // True if the buffer holds every dimension of its point format
+    bool HasAllDimensions() const;
+
+    // Vector functions
+    size_t Size() const { return size_; }
+    bool Empty() const { return size_ == 0; }
+    void Reserve(const size_t &num);
+    void Resize(const size_t &num);
+    void Clear() { Resize(0); }
+
+    // Add points functions
+    void AddPoint(const Point &point);
+    void AddPoints(const PointBuffer &points);
+
+    // Builds the Point object at the given index
+    std::shared_ptr<Point> GetPoint(const size_t &idx) const;
+    // Converts the buffer to a Points object
+    Points ToPoints() const;
+
+    // Pack/unpack
+    // Packing requires the buffer to hold all the dimensions of its point format
+    std::vector<char> Pack(const LasHeader &header) const;
+    std::vector<char> Pack(const Vector3 &scale, const Vector3 &offset) const;
+    // Packs the point at `idx` (which must be < Size()) into `out`, which must hold PointRecordLength() bytes
+    void PackPoint(const size_t &idx, char *out, const Vector3 &scale, const Vector3 &offset) const;
+    // Unpacking only reads the requested dimensions out of the point records
+    static PointBuffer Unpack(const char *point_data, size_t size, const int8_t &point_format_id,
+                              const uint16_t &eb_byte_size, const Vector3 &scale, const Vector3 &offset,
+                              const uint32_t &dimensions = Dimension::DIM_ALL);
+    static PointBuffer Unpack(const std::vector<char> &point_data, const int8_t &point_format_id,
+                              const uint16_t &eb_byte_size, const Vector3 &scale, const Vector3 &offset,
+                              const uint32_t &dimensions = Dimension::DIM_ALL);
+    static PointBuffer Unpack(const std::vector<char> &point_data, const LasHeader &header,
+                              const uint32_t &dimensions = Dimension::DIM_ALL);
+
+    // Columns
+    // The vectors can be modified in place, but must be kept the same size as the buffer
+    std::vector<double> &X() { return x_; }
+    const std::vector<double> &X() const { return x_; }
+    std::vector<double> &Y() { return y_; }
+    const std::vector<double> &Y() const { return y_; }
+    std::vector<double> &Z() { return z_; }
+    const std::vector<double> &Z() const { return z_; }
+    std::vector<uint16_t> &Intensity() { return intensity_; }
+    const std::vector<uint16_t> &Intensity() const { return intensity_; }
+    // Return number and number of returns, as in Point::ReturnsBitField
+    std::vector<uint8_t> &ReturnsBitField() { return returns_; }
+    const std::vector<uint8_t> &ReturnsBitField() const { return returns_; }
+    // Classification flags, scanner channel, scan direction and edge of flight line, as in Point::FlagsBitField
+    std::vector<uint8_t> &FlagsBitField() { return flags_; }
+    const std::vector<uint8_t> &FlagsBitField() const { return flags_; }
+    std::vector<uint8_t> &Classification() { return classification_; }
+    const std::vector<uint8_t> &Classification() const { return classification_; }
+    std::vector<uint8_t> &UserData() { return user_data_; }
+    const std::vector<uint8_t> &UserData() const { return user_data_; }
+    std::vector<int16_t> &ScanAngle() { return scan_angle_; }
+    const std::vector<int16_t> &ScanAngle() const { return scan_angle_; }
+    std::vector<uint16_t> &PointSourceId() { return point_source_id_; }
+    const std::vector<uint16_t> &PointSourceId() const { return point_source_id_; }
+    std::vector<double> &GPSTime() { return gps_time_; }
+    const std::vector<double> &GPSTime() const { return gps_time_; }
+    // Columns of dimensions the buffer doesn't hold are empty
+    std::vector<uint16_t> &Red() { return red_; }
+    const std::vector<uint16_t> &Red() const { return red_; }
+    std::vector<uint16_t> &Green() { return green_; }
+    const std::vector<uint16_t> &Green() const { return green_; }
+    std::vector<uint16_t> &Blue() { return blue_; }
+    const std::vector<uint16_t> &Blue() const { return blue_; }
+    std::vector<uint16_t> &Nir() { return nir_; }
+    const std::vector<uint16_t> &Nir() const { return nir_; }
+    // Extra bytes of all points, back to back (EbByteSize() bytes per point)
+    std::vector<uint8_t> &ExtraBytes() { return extra_bytes_; }
+    const std::vector<uint8_t> &ExtraBytes() const { return extra_bytes_; }
+
+    // Function that return true only if all points are within the box, requires DIM_XYZ
+    bool Within(const Box &box) const;
+    // Return sub-set of points that fall within the box
+    PointBuffer GetWithin(const Box &box) const;
+    // Return sub-set of points whose `mask` entry isn't 0, the mask must have one entry per point
+    PointBuffer GetSubset(const std::vector<uint8_t> &mask) const;
+
+    std::string ToString() const;
+    friend std::ostream &operator<<(std::ostream &os, PointBuffer const &value)
+    {
+        os << value.ToString();
+        return os;
+    }
+
+  private:
+    int8_t point_format_id_;
+    uint16_t eb_byte_size_;
+    uint32_t point_record_length_;
+    bool has_rgb_;
+    bool has_nir_;
+    uint32_t dimensions_;
+    size_t size_{0};
+
+    std::vector<double> x_;
+    std::vector<double> y_;
+    std::vector<double> z_;
+    std::vector<uint16_t> intensity_;
+    std::vector<uint8_t> returns_;
+    std::vector<uint8_t> flags_;
+    std::vector<uint8_t> classification_;
+    std::vector<uint8_t> user_data_;
+    std::vector<int16_t> scan_angle_;
+    std::vector<uint16_t> point_source_id_;
+    std::vector<double> gps_time_;
+    std::vector<uint16_t> red_;
+    std::vector<uint16_t> green_;
+    std::vector<uint16_t> blue_;
+    std::vector<uint16_t> nir_;
+    std::vector<uint8_t> extra_bytes_;
+
+    // Copies point `idx` of `other` to the end of this buffer
+    void PushBack(const PointBuffer &other, const size_t &idx);
+};
+} // namespace copc::las
+#endif // COPCLIB_LAS_POINT_BUFFER_H_
@@ -3,6 +3,7 @@
 
 #include <cmath>
 #include <cstdint>
+#include <cstring>
 #include <iostream>
 
 namespace copc::las
@@ -45,5 +46,14 @@ template <typename T> void pack(const T &value, std::ostream &out_stream)
     out_stream.write(reinterpret_cast<const char *>(&value), sizeof(T));
 }
 
+// Raw buffer versions, for fixed-layout records
+template <typename T> T unpack(const char *in)
+{
+    T value;
+    std::memcpy(&value, in, sizeof(T));
+    return value;
+}
+template <typename T> void pack(const T &value, char *out) { std::memcpy(out, &value, sizeof(T)); }
+
 } // namespace copc::las
 #endif // COPCLIB_LAS_UTILS_H_
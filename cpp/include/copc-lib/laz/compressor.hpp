@@ -2,12 +2,16 @@
 #define COPCLIB_LAZ_COMPRESS_H_
 
 #include <istream>
+#include <limits>
 #include <stdexcept>
 #include <vector>
 
 #include <lazperf/filestream.hpp>
 
+#include "copc-lib/copc/extents_accumulator.hpp"
 #include "copc-lib/io/copc_writer.hpp"
+#include "copc-lib/las/point_buffer.hpp"
+#include "copc-lib/las/points.hpp"
 #include "copc-lib/las/utils.hpp"
 
 using namespace lazperf;
@@ -18,50 +22,128 @@ namespace copc::laz
 class Compressor
 {
   public:
-    // Compresses bytes and writes them to the out stream
-    static int32_t CompressBytes(std::ostream &out_stream, const int8_t &point_format_id, const uint16_t &eb_byte_size,
-                                 const std::vector<char> &in)
+    // Compresses `size` bytes of packed points, feeding the compressor straight from the input buffer,
+    // and hands the compressed bytes to `out_cb`. Returns the number of points compressed.
+    static int32_t CompressBytes(const OutputCb &out_cb, const int8_t &point_format_id, const uint16_t &eb_byte_size,
+                                 const char *in, const size_t &size)
     {
-        OutFileStream stream(out_stream);
-
-        las_compressor::ptr compressor = build_las_compressor(stream.cb(), point_format_id, eb_byte_size);
-
-        int point_size = copc::las::PointByteSize(point_format_id, eb_byte_size);
-        if (in.size() % point_size != 0)
+        size_t point_size = copc::las::PointByteSize(point_format_id, eb_byte_size);
+        if (size % point_size != 0)
             throw std::runtime_error("Invalid input stream for compression!");
-        if (in.size() > std::numeric_limits<int32_t>::max())
+        if (size > static_cast<size_t>(std::numeric_limits<int32_t>::max()))
             throw std::runtime_error("Input byte stream is too large - split into multiple chunks!");
 
-        int32_t point_count = static_cast<int32_t>(in.size()) / point_size;
+        int32_t point_count = static_cast<int32_t>(size / point_size);
 
-        for (int i = 0; i < point_count; i++)
-        {
-            std::vector<char> buff =
-                std::vector<char>(in.begin() + (i * point_size), in.begin() + ((i + 1) * point_size));
-            compressor->compress(buff.data());
-        }
+        las_compressor::ptr compressor = build_las_compressor(out_cb, point_format_id, eb_byte_size);
+        for (int32_t i = 0; i < point_count; i++)
+            compressor->compress(in + static_cast<size_t>(i) * point_size);
         compressor->done();
         return point_count;
     }
 
+    // Compresses bytes and writes them to the out stream
+    static int32_t CompressBytes(std::ostream &out_stream, const int8_t &point_format_id, const uint16_t &eb_byte_size,
+                                 const char *in, const size_t &size)
+    {
+        OutFileStream stream(out_stream);
+        return CompressBytes(stream.cb(), point_format_id, eb_byte_size, in, size);
+    }
+
+    static int32_t CompressBytes(std::ostream &out_stream, const int8_t &point_format_id, const uint16_t &eb_byte_size,
+                                 const std::vector<char> &in)
+    {
+        return CompressBytes(out_stream, point_format_id, eb_byte_size, in.data(), in.size());
+    }
+
     static int32_t CompressBytes(std::ostream &out_stream, las::LasHeader const &header, const std::vector<char> &in)
     {
         return CompressBytes(out_stream, header.PointFormatId(), header.EbByteSize(), in);
     }
 
+    // Compresses bytes into a new buffer, without going through a string stream
+    static std::vector<char> CompressBytes(const char *in, const size_t &size, const int8_t &point_format_id,
+                                           const uint16_t &eb_byte_size)
+    {
+        std::vector<char> out;
+        CompressBytes(VectorOutput(out), point_format_id, eb_byte_size, in, size);
+        return out;
+    }
+
     static std::vector<char> CompressBytes(const std::vector<char> &in, const int8_t &point_format_id,
                                            const uint16_t &eb_byte_size)
     {
-        std::ostringstream out_stream;
-        CompressBytes(out_stream, point_format_id, eb_byte_size, in);
-        auto ostr = out_stream.str();
-        return std::vector<char>(ostr.begin(), ostr.end());
+        return CompressBytes(in.data(), in.size(), point_format_id, eb_byte_size);
     }
 
     static std::vector<char> CompressBytes(std::vector<char> &in, const las::LasHeader &header)
     {
         return CompressBytes(in, header.PointFormatId(), header.EbByteSize());
     }
+
+    // Compresses points one record at a time, without packing them all into an intermediate buffer first
+    static std::vector<char> CompressPoints(const las::Points &points, const las::LasHeader &header)
+    {
+        CheckFormat(points.PointFormatId(), points.PointRecordLength(), header);
+        return CompressRecords(
+            points.Size(), header,
+            [&points, &header](size_t i, char *record) { points[i]->Pack(record, header.Scale(), header.Offset()); });
+    }
+
+    static std::vector<char> CompressPoints(const las::PointBuffer &points, const las::LasHeader &header)
+    {
+        CheckFormat(points.PointFormatId(), points.PointRecordLength(), header);
+        if (!points.HasAllDimensions())
+            throw std::runtime_error("Compressor::CompressPoints: Points must hold all dimensions.");
+        return CompressRecords(points.Size(), header,
+                               [&points, &header](size_t i, char *record)
+                               { points.PackPoint(i, record, header.Scale(), header.Offset()); });
+    }
+
+    // Packs each Points with the header's scale and offset, and compresses it into its own chunk on `num_threads`
+    // threads (0 uses one thread per hardware core). Results are in the same order as `points`.
+    // If `extents` isn't null, the packed points are also added to it, so callers that compress points before
+    // writing them don't need the writer to decompress them again (see EnableAutoExtents)
+    static std::vector<std::vector<char>> CompressPoints(const std::vector<las::Points> &points,
+                                                         const las::LasHeader &header, unsigned int num_threads = 0,
+                                                         ExtentsAccumulator *extents = nullptr);
+
+  private:
+    // Appends the compressed bytes to `out`
+    static OutputCb VectorOutput(std::vector<char> &out)
+    {
+        return [&out](const unsigned char *buf, size_t len)
+        { out.insert(out.end(), reinterpret_cast<const char *>(buf), reinterpret_cast<const char *>(buf) + len); };
+    }
+
+    static void CheckFormat(const int8_t &point_format_id, const uint32_t &point_record_length,
+                            const las::LasHeader &header)
+    {
+        if (point_format_id != header.PointFormatId() || point_record_length != header.PointRecordLength())
+            throw std::runtime_error("Compressor::CompressPoints: Points must be of the same format and size as "
+                                     "the header.");
+    }
+
+    // Packs each record into a single reused buffer with `pack_record`, and compresses it
+    template <typename F>
+    static std::vector<char> CompressRecords(const size_t &point_count, const las::LasHeader &header,
+                                             const F &pack_record)
+    {
+        if (point_count > static_cast<size_t>(std::numeric_limits<int32_t>::max()))
+            throw std::runtime_error("Compressor::CompressPoints: Too many points - split into multiple chunks!");
+
+        std::vector<char> out;
+        std::vector<char> record(header.PointRecordLength());
+        las_compressor::ptr compressor =
+            build_las_compressor(VectorOutput(out), header.PointFormatId(), header.EbByteSize());
+        for (size_t i = 0; i < point_count; i++)
+        {
+            pack_record(i, record.data());
+            compressor->compress(record.data());
+        }
+        compressor->done();
+        return out;
+    }
 };
 } // namespace copc::laz
 
@@ -6,8 +6,11 @@
 #include <lazperf/filestream.hpp>
 #include <lazperf/readers.hpp>
 
+#include <cstring>
 #include <istream>
 #include <sstream>
+#include <stdexcept>
+#include <string>
 #include <vector>
 
 using namespace lazperf;
@@ -22,18 +25,14 @@ class Decompressor
     static std::vector<char> DecompressBytes(std::istream &in_stream, const int8_t &point_format_id,
                                              const uint16_t &eb_byte_size, const int &point_count)
     {
-        std::vector<char> out;
+        int point_size = copc::las::PointByteSize(point_format_id, eb_byte_size);
+        std::vector<char> out(static_cast<size_t>(point_count) * point_size);
 
         InFileStream stre(in_stream);
         las_decompressor::ptr decompressor = build_las_decompressor(stre.cb(), point_format_id, eb_byte_size);
 
-        int point_size = copc::las::PointByteSize(point_format_id, eb_byte_size);
-        char buff[255];
         for (int i = 0; i < point_count; i++)
-        {
-            decompressor->decompress(buff);
-            out.insert(out.end(), buff, buff + point_size);
-        }
+            decompressor->decompress(out.data() + static_cast<size_t>(i) * point_size);
         // clear the EOF flag, since lazperf may read too large of a buffer
         in_stream.clear();
         return out;
@@ -45,11 +44,69 @@ class Decompressor
         return DecompressBytes(in_stream, header.PointFormatId(), header.EbByteSize(), point_count);
     }
 
+    // Decompresses bytes directly from a memory buffer into `out`, without copying them into a stream first
+    // `out` must be able to hold point_count * point record length bytes
+    static void DecompressBytes(const char *compressed_data, const size_t &compressed_size,
+                                const int8_t &point_format_id, const uint16_t &eb_byte_size, const int &point_count,
+                                char *out, const size_t &out_size)
+    {
+        size_t point_size = copc::las::PointByteSize(point_format_id, eb_byte_size);
+        if (out_size < point_size * point_count)
+            throw std::runtime_error("Decompressor::DecompressBytes: Output buffer of " + std::to_string(out_size) +
+                                     " bytes is too small to hold " + std::to_string(point_count) + " points.");
+
+        // For point formats 6-8, lazperf reads the chunk's first point raw, then its point count and the byte size of
+        // every layer, and then each layer whole into its own memory buffer. Its arithmetic decoders only ever read
+        // from those buffers, so every read through the callback is inside the chunk, and reading past its end means
+        // that the chunk is truncated or holds fewer points than expected
+        size_t read_pos = 0;
+        InputCb cb = [compressed_data, compressed_size, &read_pos](unsigned char *buf, size_t len)
+        {
+            if (len > compressed_size - read_pos)
+                throw std::runtime_error("Decompressor::DecompressBytes: Compressed data of " +
+                                         std::to_string(compressed_size) + " bytes ends before all points are read.");
+            if (len > 0)
+                std::memcpy(buf, compressed_data + read_pos, len);
+            read_pos += len;
+        };
+        las_decompressor::ptr decompressor = build_las_decompressor(cb, point_format_id, eb_byte_size);
+
+        for (int i = 0; i < point_count; i++)
+            decompressor->decompress(out + static_cast<size_t>(i) * point_size);
+    }
+
+    static void DecompressBytes(const char *compressed_data, const size_t &compressed_size,
+                                const las::LasHeader &header, const int &point_count, char *out,
+                                const size_t &out_size)
+    {
+        DecompressBytes(compressed_data, compressed_size, header.PointFormatId(), header.EbByteSize(), point_count,
+                        out, out_size);
+    }
+
+    // Decompresses bytes directly from a memory buffer, without copying them into a stream first
+    static std::vector<char> DecompressBytes(const char *compressed_data, const size_t &compressed_size,
+                                             const int8_t &point_format_id, const uint16_t &eb_byte_size,
+                                             const int &point_count)
+    {
+        std::vector<char> out(static_cast<size_t>(point_count) *
+                              copc::las::PointByteSize(point_format_id, eb_byte_size));
+        DecompressBytes(compressed_data, compressed_size, point_format_id, eb_byte_size, point_count, out.data(),
+                        out.size());
+        return out;
+    }
+
+    static std::vector<char> DecompressBytes(const char *compressed_data, const size_t &compressed_size,
+                                             const las::LasHeader &header, const int &point_count)
+    {
+        return DecompressBytes(compressed_data, compressed_size, header.PointFormatId(), header.EbByteSize(),
+                               point_count);
+    }
+
     static std::vector<char> DecompressBytes(const std::vector<char> &compressed_data, const int8_t &point_format_id,
                                              const uint16_t &eb_byte_size, const int &point_count)
     {
-        std::istringstream in_stream(std::string(compressed_data.begin(), compressed_data.end()));
-        return DecompressBytes(in_stream, point_format_id, eb_byte_size, point_count);
+        return DecompressBytes(compressed_data.data(), compressed_data.size(), point_format_id, eb_byte_size,
+                               point_count);
     }
 
     static std::vector<char> DecompressBytes(const std::vector<char> &compressed_data, const las::LasHeader &header,
@@ -0,0 +1,138 @@
+#include "copc-lib/copc/extents_accumulator.hpp"
+
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+
+namespace copc
+{
+
+namespace
+{
+constexpr double SCAN_ANGLE_STEP = 0.006;
+} // namespace
+
+void ExtentsAccumulator::Add(const las::PointBuffer &points)
+{
+    if (points.Empty())
+        return;
+
+    // The batch's moments are computed with a pass per column, and then merged into the running ones
+    ExtentsAccumulator batch;
+    batch.point_count_ = points.Size();
+    for (uint8_t i = 0; i < FIELD_COUNT; i++)
+    {
+        auto field = static_cast<PointField>(i);
+        if (!Internal::HoldsField(points, field))
+            continue;
+
+        Internal::VisitField(points, field,
+                             [&](const auto &column, auto value)
+                             {
+                                 auto minimum = value(column[0]);
+                                 auto maximum = minimum;
+                                 double sum = 0;
+                                 for (const auto &v : column)
+                                 {
+                                     minimum = std::min(minimum, value(v));
+                                     maximum = std::max(maximum, value(v));
+                                     sum += static_cast<double>(value(v));
+                                 }
+                                 auto mean = sum / static_cast<double>(column.size());
+                                 // Two passes, which is more accurate than summing the squares
+                                 double m2 = 0;
+                                 for (const auto &v : column)
+                                 {
+                                     auto delta = static_cast<double>(value(v)) - mean;
+                                     m2 += delta * delta;
+                                 }
+                                 batch.moments_[field] = {static_cast<double>(minimum), static_cast<double>(maximum),
+                                                          mean, m2};
+                             });
+        batch.fields_ |= 1u << field;
+    }
+    Merge(batch);
+}
+
+void ExtentsAccumulator::Merge(const ExtentsAccumulator &other)
+{
+    if (other.point_count_ == 0)
+        return;
+    if (point_count_ == 0)
+    {
+        *this = other;
+        return;
+    }
+
+    auto count = static_cast<double>(point_count_);
+    auto other_count = static_cast<double>(other.point_count_);
+    auto total = count + other_count;
+    for (uint8_t i = 0; i < FIELD_COUNT; i++)
+    {
+        auto &a = moments_[i];
+        const auto &b = other.moments_[i];
+        auto delta = b.mean - a.mean;
+        a.minimum = std::min(a.minimum, b.minimum);
+        a.maximum = std::max(a.maximum, b.maximum);
+        a.mean += delta * other_count / total;
+        a.m2 += b.m2 + delta * delta * count * other_count / total;
+    }
+    point_count_ += other.point_count_;
+    fields_ &= other.fields_;
+}
+
+CopcExtent ExtentsAccumulator::Extent(PointField field) const
+{
+    if (!HasField(field))
+        throw std::runtime_error("ExtentsAccumulator::Extent: Accumulator doesn't hold the " + FieldName(field) +
+                                 " field.");
+    const auto &m = moments_[field];
+    return {m.minimum, m.maximum, m.mean, m.m2 / static_cast<double>(point_count_)};
+}
+
+void ExtentsAccumulator::Apply(CopcExtents &extents) const
+{
+    // PointFields are in the order of CopcExtents, and the ones past the point format's extents don't exist in it
+    auto extent_count = std::min<size_t>(PointBaseNumberExtents(extents.PointFormatId()), FIELD_COUNT);
+    auto extent_ptrs = extents.Extents();
+    for (size_t i = 0; i < extent_count; i++)
+    {
+        auto field = static_cast<PointField>(i);
+        if (!HasField(field))
+            continue;
+        auto extent = Extent(field);
+        // CopcExtents hold the scan angle in degrees, while PointBuffer holds its raw 0.006 degree steps
+        if (field == FIELD_SCAN_ANGLE)
+            extent = {extent.minimum * SCAN_ANGLE_STEP, extent.maximum * SCAN_ANGLE_STEP, extent.mean * SCAN_ANGLE_STEP,
+                      extent.var * SCAN_ANGLE_STEP * SCAN_ANGLE_STEP};
+        *extent_ptrs[i] = extent;
+    }
+}
+
+void ExtentsAccumulator::ApplyBounds(las::LasHeader &header) const
+{
+    // A file without points has no bounds
+    if (!HasField(FIELD_X))
+    {
+        header.min = Vector3();
+        header.max = Vector3();
+        return;
+    }
+    header.min = Vector3(moments_[FIELD_X].minimum, moments_[FIELD_Y].minimum, moments_[FIELD_Z].minimum);
+    header.max = Vector3(moments_[FIELD_X].maximum, moments_[FIELD_Y].maximum, moments_[FIELD_Z].maximum);
+}
+
+std::string ExtentsAccumulator::ToString() const
+{
+    std::stringstream ss;
+    ss << "ExtentsAccumulator: # of points: " << point_count_;
+    for (uint8_t i = 0; i < FIELD_COUNT; i++)
+    {
+        auto field = static_cast<PointField>(i);
+        if (HasField(field))
+            ss << ", " << FieldName(field) << ": " << Extent(field);
+    }
+    return ss.str();
+}
+
+} // namespace copc
@@ -0,0 +1,331 @@
+#include "copc-lib/copc/node_stats.hpp"
+
+#include <algorithm>
+#include <sstream>
+#include <tuple>
+
+namespace copc
+{
+
+namespace
+{
+template <typename T> void WriteValue(std::ostream &out_stream, T value)
+{
+    out_stream.write(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+template <typename T> T ReadValue(std::istream &in_stream)
+{
+    T value;
+    in_stream.read(reinterpret_cast<char *>(&value), sizeof(value));
+    if (!in_stream.good())
+        throw std::runtime_error("NodeStats::Unpack: Unexpected end of data.");
+    return value;
+}
+} // namespace
+
+uint32_t FieldDimension(PointField field)
+{
+    switch (field)
+    {
+    case FIELD_X:
+    case FIELD_Y:
+    case FIELD_Z:
+        return las::Dimension::DIM_XYZ;
+    case FIELD_INTENSITY:
+        return las::Dimension::DIM_INTENSITY;
+    case FIELD_RETURN_NUMBER:
+    case FIELD_NUMBER_OF_RETURNS:
+        return las::Dimension::DIM_RETURNS;
+    case FIELD_SCANNER_CHANNEL:
+    case FIELD_SCAN_DIRECTION_FLAG:
+    case FIELD_EDGE_OF_FLIGHT_LINE:
+        return las::Dimension::DIM_FLAGS;
+    case FIELD_CLASSIFICATION:
+        return las::Dimension::DIM_CLASSIFICATION;
+    case FIELD_USER_DATA:
+        return las::Dimension::DIM_USER_DATA;
+    case FIELD_SCAN_ANGLE:
+        return las::Dimension::DIM_SCAN_ANGLE;
+    case FIELD_POINT_SOURCE_ID:
+        return las::Dimension::DIM_POINT_SOURCE_ID;
+    case FIELD_GPS_TIME:
+        return las::Dimension::DIM_GPS_TIME;
+    case FIELD_RED:
+    case FIELD_GREEN:
+    case FIELD_BLUE:
+        return las::Dimension::DIM_RGB;
+    case FIELD_NIR:
+        return las::Dimension::DIM_NIR;
+    default:
+        throw std::runtime_error("FieldDimension: Invalid point field.");
+    }
+}
+
+std::string FieldName(PointField field)
+{
+    switch (field)
+    {
+    case FIELD_X:
+        return "X";
+    case FIELD_Y:
+        return "Y";
+    case FIELD_Z:
+        return "Z";
+    case FIELD_INTENSITY:
+        return "Intensity";
+    case FIELD_RETURN_NUMBER:
+        return "ReturnNumber";
+    case FIELD_NUMBER_OF_RETURNS:
+        return "NumberOfReturns";
+    case FIELD_SCANNER_CHANNEL:
+        return "ScannerChannel";
+    case FIELD_SCAN_DIRECTION_FLAG:
+        return "ScanDirectionFlag";
+    case FIELD_EDGE_OF_FLIGHT_LINE:
+        return "EdgeOfFlightLine";
+    case FIELD_CLASSIFICATION:
+        return "Classification";
+    case FIELD_USER_DATA:
+        return "UserData";
+    case FIELD_SCAN_ANGLE:
+        return "ScanAngle";
+    case FIELD_POINT_SOURCE_ID:
+        return "PointSourceId";
+    case FIELD_GPS_TIME:
+        return "GpsTime";
+    case FIELD_RED:
+        return "Red";
+    case FIELD_GREEN:
+        return "Green";
+    case FIELD_BLUE:
+        return "Blue";
+    case FIELD_NIR:
+        return "Nir";
+    default:
+        throw std::runtime_error("FieldName: Invalid point field.");
+    }
+}
+
+NodeStats NodeStats::FromPoints(const las::PointBuffer &points)
+{
+    NodeStats stats;
+    stats.point_count_ = points.Size();
+    if (points.Empty())
+        return stats;
+
+    for (uint8_t i = 0; i < FIELD_COUNT; i++)
+    {
+        auto field = static_cast<PointField>(i);
+        if (!Internal::HoldsField(points, field))
+            continue;
+
+        Internal::VisitField(points, field,
+                             [&](const auto &column, auto value)
+                             {
+                                 auto minimum = value(column[0]);
+                                 auto maximum = minimum;
+                                 for (const auto &v : column)
+                                 {
+                                     minimum = std::min(minimum, value(v));
+                                     maximum = std::max(maximum, value(v));
+                                 }
+                                 stats.minimum_[field] = static_cast<double>(minimum);
+                                 stats.maximum_[field] = static_cast<double>(maximum);
+                             });
+        stats.fields_ |= 1u << field;
+    }
+
+    if (stats.HasField(FIELD_CLASSIFICATION))
+    {
+        std::array<uint64_t, 256> counts{};
+        for (auto classification : points.Classification())
+            counts[classification]++;
+        for (size_t i = 0; i < counts.size(); i++)
+        {
+            if (counts[i] > 0)
+                stats.classification_counts_.emplace_back(static_cast<uint8_t>(i), counts[i]);
+        }
+    }
+    return stats;
+}
+
+void NodeStats::Merge(const NodeStats &other)
+{
+    if (other.point_count_ == 0)
+        return;
+    if (point_count_ == 0)
+    {
+        *this = other;
+        return;
+    }
+
+    point_count_ += other.point_count_;
+    fields_ &= other.fields_;
+    for (uint8_t i = 0; i < FIELD_COUNT; i++)
+    {
+        minimum_[i] = std::min(minimum_[i], other.minimum_[i]);
+        maximum_[i] = std::max(maximum_[i], other.maximum_[i]);
+    }
+
+    if (!HasField(FIELD_CLASSIFICATION))
+    {
+        classification_counts_.clear();
+        return;
+    }
+    // Both histograms are sorted by class
+    std::vector<std::pair<uint8_t, uint64_t>> merged;
+    merged.reserve(classification_counts_.size() + other.classification_counts_.size());
+    auto a = classification_counts_.begin();
+    auto b = other.classification_counts_.begin();
+    while (a != classification_counts_.end() || b != other.classification_counts_.end())
+    {
+        if (b == other.classification_counts_.end() || (a != classification_counts_.end() && a->first < b->first))
+            merged.push_back(*a++);
+        else if (a == classification_counts_.end() || b->first < a->first)
+            merged.push_back(*b++);
+        else
+        {
+            merged.emplace_back(a->first, a->second + b->second);
+            a++;
+            b++;
+        }
+    }
+    classification_counts_ = std::move(merged);
+}
+
+double NodeStats::Minimum(PointField field) const
+{
+    if (!HasField(field))
+        throw std::runtime_error("NodeStats::Minimum: Stats don't hold the " + FieldName(field) + " field.");
+    return minimum_[field];
+}
+
+double NodeStats::Maximum(PointField field) const
+{
+    if (!HasField(field))
+        throw std::runtime_error("NodeStats::Maximum: Stats don't hold the " + FieldName(field) + " field.");
+    return maximum_[field];
+}
+
+uint64_t NodeStats::ClassificationCount(uint8_t classification) const
+{
+    auto it = std::lower_bound(classification_counts_.begin(), classification_counts_.end(), classification,
+                               [](const std::pair<uint8_t, uint64_t> &bin, uint8_t c) { return bin.first < c; });
+    if (it == classification_counts_.end() || it->first != classification)
+        return 0;
+    return it->second;
+}
+
+void NodeStats::Pack(std::ostream &out_stream) const
+{
+    WriteValue(out_stream, point_count_);
+    WriteValue(out_stream, fields_);
+    for (uint8_t i = 0; i < FIELD_COUNT; i++)
+    {
+        if (!HasField(static_cast<PointField>(i)))
+            continue;
+        WriteValue(out_stream, minimum_[i]);
+        WriteValue(out_stream, maximum_[i]);
+    }
+    if (HasField(FIELD_CLASSIFICATION))
+    {
+        WriteValue(out_stream, static_cast<uint16_t>(classification_counts_.size()));
+        for (const auto &bin : classification_counts_)
+        {
+            WriteValue(out_stream, bin.first);
+            WriteValue(out_stream, bin.second);
+        }
+    }
+}
+
+NodeStats NodeStats::Unpack(std::istream &in_stream)
+{
+    NodeStats stats;
+    stats.point_count_ = ReadValue<uint64_t>(in_stream);
+    stats.fields_ = ReadValue<uint32_t>(in_stream);
+    if (stats.fields_ >> FIELD_COUNT != 0)
+        throw std::runtime_error("NodeStats::Unpack: Unknown fields.");
+    for (uint8_t i = 0; i < FIELD_COUNT; i++)
+    {
+        if (!stats.HasField(static_cast<PointField>(i)))
+            continue;
+        stats.minimum_[i] = ReadValue<double>(in_stream);
+        stats.maximum_[i] = ReadValue<double>(in_stream);
+    }
+    if (stats.HasField(FIELD_CLASSIFICATION))
+    {
+        auto bin_count = ReadValue<uint16_t>(in_stream);
+        stats.classification_counts_.reserve(bin_count);
+        for (uint16_t i = 0; i < bin_count; i++)
+        {
+            auto classification = ReadValue<uint8_t>(in_stream);
+            auto count = ReadValue<uint64_t>(in_stream);
+            stats.classification_counts_.emplace_back(classification, count);
+        }
+    }
+    return stats;
+}
+
+std::vector<char> NodeStats::PackNodes(const std::unordered_map<VoxelKey, NodeStats> &nodes)
+{
+    // Sort the keys, so the same stats always give the same bytes
+    std::vector<VoxelKey> keys;
+    keys.reserve(nodes.size());
+    for (const auto &node : nodes)
+        keys.push_back(node.first);
+    std::sort(keys.begin(), keys.end(),
+              [](const VoxelKey &a, const VoxelKey &b)
+              { return std::tie(a.d, a.x, a.y, a.z) < std::tie(b.d, b.x, b.y, b.z); });
+
+    std::stringstream out_stream;
+    for (const auto &key : keys)
+    {
+        WriteValue(out_stream, key.d);
+        WriteValue(out_stream, key.x);
+        WriteValue(out_stream, key.y);
+        WriteValue(out_stream, key.z);
+        nodes.at(key).Pack(out_stream);
+    }
+    auto str = out_stream.str();
+    return std::vector<char>(str.begin(), str.end());
+}
+
+std::unordered_map<VoxelKey, NodeStats> NodeStats::UnpackNodes(const std::vector<char> &data)
+{
+    std::istringstream in_stream(std::string(data.begin(), data.end()));
+    std::unordered_map<VoxelKey, NodeStats> nodes;
+    while (static_cast<size_t>(in_stream.tellg()) < data.size())
+    {
+        auto d = ReadValue<int32_t>(in_stream);
+        auto x = ReadValue<int32_t>(in_stream);
+        auto y = ReadValue<int32_t>(in_stream);
+        auto z = ReadValue<int32_t>(in_stream);
+        VoxelKey key(d, x, y, z);
+        if (!key.IsValid())
+            throw std::runtime_error("NodeStats::UnpackNodes: Invalid key " + key.ToString() + ".");
+        nodes[key] = Unpack(in_stream);
+    }
+    return nodes;
+}
+
+std::string NodeStats::ToString() const
+{
+    std::stringstream ss;
+    ss << "NodeStats: # of points: " << point_count_;
+    for (uint8_t i = 0; i < FIELD_COUNT; i++)
+    {
+        auto field = static_cast<PointField>(i);
+        if (HasField(field))
+            ss << ", " << FieldName(field) << ": (" << minimum_[i] << "/" << maximum_[i] << ")";
+    }
+    if (!classification_counts_.empty())
+    {
+        ss << ", Classifications:";
+        for (const auto &bin : classification_counts_)
+            ss << " " << static_cast<int>(bin.first) << "=" << bin.second;
+    }
+    return ss.str();
+}
+
+} // namespace copc
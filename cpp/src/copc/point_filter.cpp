@@ -0,0 +1,162 @@
+#include "copc-lib/copc/point_filter.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+#include <type_traits>
+
+namespace copc
+{
+
+PointFilter &PointFilter::Range(PointField field, double minimum, double maximum)
+{
+    FieldDimension(field); // Throws on invalid fields
+    if (std::isnan(minimum) || std::isnan(maximum) || minimum > maximum)
+        throw std::runtime_error("PointFilter::Range: Minimum value must be less or equal than maximum value.");
+    conditions_.push_back({field, true, minimum, maximum, {}});
+    return *this;
+}
+
+PointFilter &PointFilter::In(PointField field, const std::vector<double> &values)
+{
+    FieldDimension(field); // Throws on invalid fields
+    conditions_.push_back({field, false, 0, 0, values});
+    return *this;
+}
+
+uint32_t PointFilter::RequiredDimensions() const
+{
+    uint32_t dimensions = 0;
+    for (const auto &condition : conditions_)
+        dimensions |= FieldDimension(condition.field);
+    return dimensions;
+}
+
+bool PointFilter::MayMatch(const NodeStats &stats) const
+{
+    for (const auto &condition : conditions_)
+    {
+        if (!stats.HasField(condition.field))
+            continue;
+
+        auto minimum = stats.Minimum(condition.field);
+        auto maximum = stats.Maximum(condition.field);
+        if (condition.is_range)
+        {
+            if (maximum < condition.minimum || minimum > condition.maximum)
+                return false;
+            continue;
+        }
+
+        bool any = false;
+        for (auto value : condition.values)
+        {
+            if (condition.field == FIELD_CLASSIFICATION)
+            {
+                // The histogram rules out classes between the min and the max that the node doesn't have
+                any = value >= 0 && value <= 255 && value == std::floor(value) &&
+                      stats.ClassificationCount(static_cast<uint8_t>(value)) > 0;
+            }
+            else
+            {
+                any = value >= minimum && value <= maximum;
+            }
+            if (any)
+                break;
+        }
+        if (!any)
+            return false;
+    }
+    return true;
+}
+
+std::vector<uint8_t> PointFilter::Mask(const las::PointBuffer &points) const
+{
+    auto required = RequiredDimensions();
+    if ((points.Dimensions() & required) != required)
+        throw std::runtime_error("PointFilter::Mask: Points don't hold the dimensions the filter needs.");
+
+    std::vector<uint8_t> mask(points.Size(), 1);
+    for (const auto &condition : conditions_)
+    {
+        // Each condition is a tight loop over a single column, that ANDs its result into the mask without branching
+        Internal::VisitField(
+            points, condition.field,
+            [&](const auto &column, auto value)
+            {
+                using T = std::decay_t<decltype(column[0])>;
+                if (condition.is_range)
+                {
+                    const auto minimum = condition.minimum;
+                    const auto maximum = condition.maximum;
+                    for (size_t i = 0; i < column.size(); i++)
+                    {
+                        auto v = static_cast<double>(value(column[i]));
+                        mask[i] &= static_cast<uint8_t>((v >= minimum) & (v <= maximum));
+                    }
+                }
+                else if constexpr (sizeof(T) == 1)
+                {
+                    // Byte columns only have 256 possible values, so the condition becomes a table lookup
+                    std::array<uint8_t, 256> table{};
+                    for (size_t raw = 0; raw < table.size(); raw++)
+                    {
+                        auto v = static_cast<double>(value(static_cast<T>(raw)));
+                        table[raw] = std::find(condition.values.begin(), condition.values.end(), v) !=
+                                     condition.values.end();
+                    }
+                    for (size_t i = 0; i < column.size(); i++)
+                        mask[i] &= table[static_cast<uint8_t>(column[i])];
+                }
+                else
+                {
+                    for (size_t i = 0; i < column.size(); i++)
+                    {
+                        auto v = static_cast<double>(value(column[i]));
+                        uint8_t match = 0;
+                        for (auto x : condition.values)
+                            match |= static_cast<uint8_t>(v == x);
+                        mask[i] &= match;
+                    }
+                }
+            });
+    }
+    return mask;
+}
+
+las::PointBuffer PointFilter::Apply(const las::PointBuffer &points) const
+{
+    if (Empty())
+        return points;
+    return points.GetSubset(Mask(points));
+}
+
+std::string PointFilter::ToString() const
+{
+    if (Empty())
+        return "PointFilter: All points";
+
+    std::stringstream ss;
+    ss << "PointFilter: ";
+    for (size_t i = 0; i < conditions_.size(); i++)
+    {
+        const auto &condition = conditions_[i];
+        if (i > 0)
+            ss << " and ";
+        ss << FieldName(condition.field) << " in ";
+        if (condition.is_range)
+        {
+            ss << "[" << condition.minimum << ", " << condition.maximum << "]";
+            continue;
+        }
+        ss << "{";
+        for (size_t j = 0; j < condition.values.size(); j++)
+            ss << (j > 0 ? ", " : "") << condition.values[j];
+        ss << "}";
+    }
+    return ss.str();
+}
+
+} // namespace copc
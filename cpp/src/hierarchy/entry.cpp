@@ -0,0 +1,60 @@
+#include "copc-lib/hierarchy/entry.hpp"
+
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+namespace copc
+{
+
+namespace
+{
+// Entries are stored little-endian, assembling the bytes keeps this correct on any host
+// (compilers turn it into a plain load on little-endian ones)
+template <typename T> T LoadLittleEndian(const char *data)
+{
+    using U = std::make_unsigned_t<T>;
+    U value = 0;
+    for (size_t i = 0; i < sizeof(T); i++)
+        value |= static_cast<U>(static_cast<unsigned char>(data[i])) << (8 * i);
+    return static_cast<T>(value);
+}
+} // namespace
+
+std::vector<Entry> Entry::UnpackEntries(const char *data, size_t byte_size)
+{
+    if (byte_size % ENTRY_SIZE != 0)
+        throw std::runtime_error("Entry::UnpackEntries: Page size " + std::to_string(byte_size) +
+                                 " is not a multiple of the entry size.");
+
+    size_t num_entries = byte_size / ENTRY_SIZE;
+    std::vector<Entry> out;
+    out.reserve(num_entries);
+
+    // The sign bits of every field that must be positive are OR'd together, so validation doesn't branch per entry
+    int32_t invalid = 0;
+    for (size_t i = 0; i < num_entries; i++)
+    {
+        const char *entry = data + i * ENTRY_SIZE;
+        VoxelKey key(LoadLittleEndian<int32_t>(entry), LoadLittleEndian<int32_t>(entry + 4),
+                     LoadLittleEndian<int32_t>(entry + 8), LoadLittleEndian<int32_t>(entry + 12));
+        auto offset = LoadLittleEndian<uint64_t>(entry + 16);
+        auto size = LoadLittleEndian<int32_t>(entry + 24);
+        auto point_count = LoadLittleEndian<int32_t>(entry + 28);
+
+        invalid |= key.d | key.x | key.y | key.z | size;
+        out.emplace_back(key, offset, size, point_count);
+    }
+
+    if (invalid < 0)
+    {
+        for (const auto &e : out)
+        {
+            if (!e.IsValid())
+                throw std::runtime_error("Entry is invalid! " + e.ToString());
+        }
+    }
+    return out;
+}
+
+} // namespace copc
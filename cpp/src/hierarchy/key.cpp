@@ -80,12 +80,14 @@ std::vector<VoxelKey> VoxelKey::GetParents(bool include_self) const
 
 bool VoxelKey::ChildOf(VoxelKey parent_key) const
 {
-    for (auto parent : GetParents(true))
-    {
-        if (parent == parent_key)
-            return true;
-    }
-    return false;
+    if (!IsValid() || !parent_key.IsValid() || parent_key.d > d)
+        return false;
+
+    // Each level up halves the coordinates, so the ancestor at parent_key's depth is one shift away
+    int32_t shift = d - parent_key.d;
+    if (shift > 30)
+        return parent_key.x == 0 && parent_key.y == 0 && parent_key.z == 0;
+    return (x >> shift) == parent_key.x && (y >> shift) == parent_key.y && (z >> shift) == parent_key.z;
 }
 
 double VoxelKey::Resolution(const las::LasHeader &header, const CopcInfo &copc_info) const
@@ -0,0 +1,170 @@
+#include "copc-lib/hierarchy/morton_key.hpp"
+
+#include <stdexcept>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace copc
+{
+
+namespace
+{
+// Spreads the low 21 bits of `v` out so there are two zero bits between each of them
+uint64_t Spread(uint64_t v)
+{
+    v &= 0x1fffff;
+    v = (v | v << 32) & 0x1f00000000ffffull;
+    v = (v | v << 16) & 0x1f0000ff0000ffull;
+    v = (v | v << 8) & 0x100f00f00f00f00full;
+    v = (v | v << 4) & 0x10c30c30c30c30c3ull;
+    v = (v | v << 2) & 0x1249249249249249ull;
+    return v;
+}
+
+// Inverse of Spread
+uint32_t Compact(uint64_t v)
+{
+    v &= 0x1249249249249249ull;
+    v = (v ^ (v >> 2)) & 0x10c30c30c30c30c3ull;
+    v = (v ^ (v >> 4)) & 0x100f00f00f00f00full;
+    v = (v ^ (v >> 8)) & 0x1f0000ff0000ffull;
+    v = (v ^ (v >> 16)) & 0x1f00000000ffffull;
+    v = (v ^ (v >> 32)) & 0x1fffff;
+    return static_cast<uint32_t>(v);
+}
+
+// Index of the highest set bit, `v` must not be 0
+int HighestBit(uint64_t v)
+{
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanReverse64(&index, v);
+    return static_cast<int>(index);
+#else
+    return 63 - __builtin_clzll(v);
+#endif
+}
+} // namespace
+
+MortonKey::MortonKey(const VoxelKey &key)
+{
+    if (!Representable(key))
+        throw std::runtime_error("MortonKey: Key " + key.ToString() + " cannot be represented as a Morton code.");
+
+    code_ = (uint64_t(1) << (3 * key.d)) | Spread(key.x) | (Spread(key.y) << 1) | (Spread(key.z) << 2);
+}
+
+MortonKey MortonKey::FromCode(uint64_t code)
+{
+    if (code == 0 || HighestBit(code) % 3 != 0)
+        throw std::runtime_error("MortonKey::FromCode: Invalid Morton code.");
+    return MortonKey(code);
+}
+
+bool MortonKey::Representable(const VoxelKey &key)
+{
+    if (!key.IsValid() || key.d > MAX_DEPTH)
+        return false;
+    int64_t size = int64_t(1) << key.d;
+    return key.x < size && key.y < size && key.z < size;
+}
+
+int32_t MortonKey::Depth() const
+{
+    if (!IsValid())
+        return -1;
+    return HighestBit(code_) / 3;
+}
+
+VoxelKey MortonKey::ToVoxelKey() const
+{
+    if (!IsValid())
+        return VoxelKey::InvalidKey();
+    uint64_t bits = code_ ^ (uint64_t(1) << (3 * Depth()));
+    return VoxelKey(Depth(), static_cast<int32_t>(Compact(bits)), static_cast<int32_t>(Compact(bits >> 1)),
+                    static_cast<int32_t>(Compact(bits >> 2)));
+}
+
+std::string MortonKey::ToString() const { return "MortonKey " + ToVoxelKey().ToString(); }
+
+MortonKey MortonKey::ParentAtDepth(int32_t depth) const
+{
+    if (!IsValid())
+        return {};
+    if (depth < 0 || depth > Depth())
+        throw std::runtime_error("MortonKey::ParentAtDepth: Invalid depth requested.");
+    return MortonKey(code_ >> (3 * (Depth() - depth)));
+}
+
+MortonKey MortonKey::Child(int direction) const
+{
+    if (!IsValid() || Depth() >= MAX_DEPTH)
+        throw std::runtime_error("MortonKey::Child: Key has no representable children.");
+    if (direction < 0 || direction > 7)
+        throw std::runtime_error("MortonKey::Child: Direction must be in [0,7].");
+    return MortonKey(code_ << 3 | static_cast<uint64_t>(direction));
+}
+
+std::vector<MortonKey> MortonKey::Children() const
+{
+    std::vector<MortonKey> children;
+    children.reserve(8);
+    for (int i = 0; i < 8; i++)
+        children.push_back(Child(i));
+    return children;
+}
+
+std::vector<MortonKey> MortonKey::Siblings() const
+{
+    std::vector<MortonKey> siblings;
+    if (!IsValid() || Depth() == 0)
+        return siblings;
+
+    siblings.reserve(7);
+    uint64_t first = code_ & ~uint64_t(7);
+    for (uint64_t i = 0; i < 8; i++)
+    {
+        if ((first | i) != code_)
+            siblings.push_back(MortonKey(first | i));
+    }
+    return siblings;
+}
+
+bool MortonKey::ChildOf(const MortonKey &ancestor) const
+{
+    if (!IsValid() || !ancestor.IsValid())
+        return false;
+    int32_t shift = Depth() - ancestor.Depth();
+    return shift >= 0 && (code_ >> (3 * shift)) == ancestor.code_;
+}
+
+uint64_t MortonKey::PreorderPosition() const
+{
+    if (!IsValid())
+        return 0;
+    int32_t depth = Depth();
+    uint64_t bits = code_ ^ (uint64_t(1) << (3 * depth));
+    return bits << (3 * (MAX_DEPTH - depth));
+}
+
+std::pair<uint64_t, uint64_t> MortonKey::DescendantRange() const
+{
+    if (!IsValid())
+        return {0, 0};
+    uint64_t begin = PreorderPosition();
+    return {begin, begin + (uint64_t(1) << (3 * (MAX_DEPTH - Depth())))};
+}
+
+bool MortonKey::PreorderLess(const MortonKey &a, const MortonKey &b)
+{
+    auto a_position = a.PreorderPosition();
+    auto b_position = b.PreorderPosition();
+    if (a_position != b_position)
+        return a_position < b_position;
+    // Same first cell, so one is an ancestor of the other, and comes first
+    return a.Depth() < b.Depth();
+}
+
+} // namespace copc
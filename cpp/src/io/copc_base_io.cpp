@@ -2,23 +2,24 @@
 #include "copc-lib/hierarchy/internal/hierarchy.hpp"
 #include "copc-lib/hierarchy/internal/page.hpp"
 
+#include <algorithm>
+#include <mutex>
+
 namespace copc
 {
 
 // Find a node object given a key
 Node BaseIO::FindNode(VoxelKey key)
 {
-    // Check if the entry has already been loaded
-    if (hierarchy_->loaded_nodes_.find(key) != hierarchy_->loaded_nodes_.end())
-    {
-        return *hierarchy_->loaded_nodes_[key];
-    }
+    std::lock_guard<std::recursive_mutex> lock(hierarchy_->mutex_);
 
-    // Get a list of the key's hierarchial parents, so we can see if any of them are loaded
-    auto parents_list = key.GetParents(true);
+    // Check if the entry has already been loaded
+    Node node;
+    if (hierarchy_->FindLoadedNode(key, node))
+        return node;
 
     // Find if of the key's ancestors have been seen
-    std::shared_ptr<Internal::PageInternal> nearest_page = hierarchy_->NearestLoadedPage(parents_list);
+    std::shared_ptr<Internal::PageInternal> nearest_page = hierarchy_->NearestLoadedPage(key);
     // If none of the key's ancestors exist, then this key doesn't exist in the hierarchy
     // Or, if the nearest ancestor has already been loaded, that means the key isn't a node within that page.
     if (nearest_page == nullptr || nearest_page->loaded)
@@ -36,6 +37,7 @@ void BaseIO::LoadPageHierarchy(const std::shared_ptr<Internal::PageInternal> &pa
     if (!page->IsValid())
         return;
 
+    std::lock_guard<std::recursive_mutex> lock(hierarchy_->mutex_);
     if (!page->loaded)
         ReadAndParsePage(page);
 
@@ -47,25 +49,32 @@ void BaseIO::LoadPageHierarchy(const std::shared_ptr<Internal::PageInternal> &pa
     {
         loaded_nodes.push_back(*node.second);
     }
+    hierarchy_->node_index_.AppendPageNodes(page->key, loaded_nodes);
 }
 
 void BaseIO::ReadAndParsePage(const std::shared_ptr<Internal::PageInternal> &page)
 {
-    auto children = ReadPage(page);
-    for (const Entry &e : children)
+    AddPageEntries(page, ReadPage(page));
+}
+
+void BaseIO::AddPageEntries(const std::shared_ptr<Internal::PageInternal> &page, const std::vector<Entry> &entries)
+{
+    for (const Entry &e : entries)
     {
         if (e.IsPage())
         {
             auto subpage = std::make_shared<Internal::PageInternal>(e);
             hierarchy_->seen_pages_[e.key] = subpage;
             page->sub_pages.insert(subpage);
+            hierarchy_->pending_pages_++;
         }
         else
         {
-            auto node = std::make_shared<Node>(e, page->key);
-            hierarchy_->loaded_nodes_[e.key] = node;
-            page->nodes[node->key] = node;
+            hierarchy_->max_loaded_depth_ = std::max(hierarchy_->max_loaded_depth_, e.key.d);
         }
     }
+    hierarchy_->node_index_.AddPage(page->key, entries);
+    if (hierarchy_->pending_pages_ > 0)
+        hierarchy_->pending_pages_--;
 }
 } // namespace copc
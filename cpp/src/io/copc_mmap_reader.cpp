@@ -0,0 +1,194 @@
+#include "copc-lib/io/copc_mmap_reader.hpp"
+
+#include <cstring>
+#include <stdexcept>
+
+#include "copc-lib/hierarchy/internal/page.hpp"
+#include "copc-lib/io/internal/memory_stream.hpp"
+#include "copc-lib/laz/decompressor.hpp"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace copc
+{
+
+MmapReader::MmapReader(const std::string &file_path) : file_path_(file_path)
+{
+    Map();
+    is_open_ = true;
+
+    // The header and VLRs are parsed by lazperf through a stream, so wrap the mapping without copying it
+    stream_buf_ = std::make_unique<Internal::MemoryStreamBuf>(data_, size_);
+    stream_ = std::make_unique<std::istream>(stream_buf_.get());
+    in_stream_ = stream_.get();
+
+    try
+    {
+        InitReader();
+        InitCopcReader();
+    }
+    catch (...)
+    {
+        Close();
+        throw;
+    }
+}
+
+MmapReader::~MmapReader() { Close(); }
+
+void MmapReader::Close()
+{
+    if (is_open_)
+    {
+        in_stream_ = nullptr;
+        stream_.reset();
+        stream_buf_.reset();
+        Unmap();
+        is_open_ = false;
+    }
+}
+
+#ifdef _WIN32
+void MmapReader::Map()
+{
+    HANDLE file = CreateFileA(file_path_.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        throw std::runtime_error("MmapReader: Error while opening file path.");
+
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0)
+    {
+        CloseHandle(file);
+        throw std::runtime_error("MmapReader: Error while reading file size.");
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr)
+    {
+        CloseHandle(file);
+        throw std::runtime_error("MmapReader: Error while mapping file.");
+    }
+
+    void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (view == nullptr)
+    {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        throw std::runtime_error("MmapReader: Error while mapping file.");
+    }
+
+    file_handle_ = file;
+    mapping_handle_ = mapping;
+    data_ = static_cast<const char *>(view);
+    size_ = static_cast<size_t>(file_size.QuadPart);
+}
+
+void MmapReader::Unmap()
+{
+    if (data_ != nullptr)
+        UnmapViewOfFile(data_);
+    if (mapping_handle_ != nullptr)
+        CloseHandle(static_cast<HANDLE>(mapping_handle_));
+    if (file_handle_ != nullptr)
+        CloseHandle(static_cast<HANDLE>(file_handle_));
+    data_ = nullptr;
+    mapping_handle_ = nullptr;
+    file_handle_ = nullptr;
+    size_ = 0;
+}
+#else
+void MmapReader::Map()
+{
+    int fd = open(file_path_.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw std::runtime_error("MmapReader: Error while opening file path.");
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0)
+    {
+        close(fd);
+        throw std::runtime_error("MmapReader: Error while reading file size.");
+    }
+
+    void *view = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    // The mapping holds its own reference to the file, so the descriptor isn't needed anymore
+    close(fd);
+    if (view == MAP_FAILED)
+        throw std::runtime_error("MmapReader: Error while mapping file.");
+
+    // Node reads jump around the file, so readahead mostly wastes page cache
+    madvise(view, static_cast<size_t>(st.st_size), MADV_RANDOM);
+
+    data_ = static_cast<const char *>(view);
+    size_ = static_cast<size_t>(st.st_size);
+}
+
+void MmapReader::Unmap()
+{
+    if (data_ != nullptr)
+        munmap(const_cast<char *>(data_), size_);
+    data_ = nullptr;
+    size_ = 0;
+}
+#endif
+
+void MmapReader::CheckRange(uint64_t offset, uint64_t size, const std::string &caller) const
+{
+    if (!is_open_)
+        throw std::runtime_error("MmapReader::" + caller + ": Reader is closed.");
+    if (offset > size_ || size > size_ - offset)
+        throw std::runtime_error("MmapReader::" + caller + ": Requested range is outside of the file.");
+}
+
+std::vector<Entry> MmapReader::ReadPage(std::shared_ptr<Internal::PageInternal> page)
+{
+    std::vector<Entry> out;
+    if (!page->IsValid())
+        throw std::runtime_error("MmapReader::ReadPage: Cannot load an invalid page.");
+
+    CheckRange(page->offset, page->byte_size, "ReadPage");
+
+    out = ParsePage(data_ + page->offset, page->byte_size);
+    page->loaded = true;
+    return out;
+}
+
+void MmapReader::ReadFileBytes(uint64_t offset, char *out, size_t size)
+{
+    CheckRange(offset, size, "ReadFileBytes");
+    std::memcpy(out, data_ + offset, size);
+}
+
+void MmapReader::ReadPointData(Node const &node, char *out, size_t out_size)
+{
+    if (!node.IsValid())
+        throw std::runtime_error("MmapReader::GetPointData: Cannot load an invalid node.");
+
+    CheckRange(node.offset, node.byte_size, "GetPointData");
+
+    DecompressNode(node, data_ + node.offset, node.byte_size, out, out_size);
+}
+
+std::vector<char> MmapReader::GetPointDataCompressed(Node const &node)
+{
+    if (!node.IsValid())
+        throw std::runtime_error("MmapReader::GetPointDataCompressed: Cannot load an invalid node.");
+
+    CheckRange(node.offset, node.byte_size, "GetPointDataCompressed");
+
+    const char *begin = data_ + node.offset;
+    return std::vector<char>(begin, begin + node.byte_size);
+}
+
+} // namespace copc
@@ -0,0 +1,138 @@
+#include "copc-lib/io/copc_pread_reader.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <stdexcept>
+
+#include "copc-lib/hierarchy/internal/page.hpp"
+#include "copc-lib/laz/decompressor.hpp"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace copc
+{
+
+PreadReader::PreadReader(const std::string &file_path) : file_path_(file_path)
+{
+#ifdef _WIN32
+    HANDLE file = CreateFileA(file_path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        throw std::runtime_error("PreadReader: Error while opening file path.");
+    file_handle_ = file;
+#else
+    fd_ = open(file_path.c_str(), O_RDONLY);
+    if (fd_ < 0)
+        throw std::runtime_error("PreadReader: Error while opening file path.");
+#endif
+    is_open_ = true;
+
+    // lazperf parses the header and VLRs through a stream; after that the stream isn't read from again
+    init_stream_ = std::make_unique<std::ifstream>(file_path, std::ios::in | std::ios::binary);
+    in_stream_ = init_stream_.get();
+
+    try
+    {
+        InitReader();
+        InitCopcReader();
+    }
+    catch (...)
+    {
+        Close();
+        throw;
+    }
+    CloseInitStream();
+}
+
+void PreadReader::CloseInitStream()
+{
+    // lazperf's reader holds on to the stream, so it goes first. Without in_stream_, any read that would still go
+    // through the shared cursor throws instead of racing with other threads
+    reader_.reset();
+    in_stream_ = nullptr;
+    init_stream_.reset();
+}
+
+void PreadReader::Close()
+{
+    if (is_open_)
+    {
+        CloseInitStream();
+#ifdef _WIN32
+        CloseHandle(static_cast<HANDLE>(file_handle_));
+        file_handle_ = nullptr;
+#else
+        close(fd_);
+        fd_ = -1;
+#endif
+        is_open_ = false;
+    }
+}
+
+void PreadReader::ReadAt(uint64_t offset, char *out, size_t size, const std::string &caller) const
+{
+    if (!is_open_)
+        throw std::runtime_error("PreadReader::" + caller + ": Reader is closed.");
+
+    size_t total = 0;
+    while (total < size)
+    {
+#ifdef _WIN32
+        OVERLAPPED overlapped{};
+        uint64_t pos = offset + total;
+        overlapped.Offset = static_cast<DWORD>(pos & 0xFFFFFFFF);
+        overlapped.OffsetHigh = static_cast<DWORD>(pos >> 32);
+        DWORD to_read = static_cast<DWORD>(std::min<size_t>(size - total, 1u << 30));
+        DWORD read = 0;
+        if (!ReadFile(static_cast<HANDLE>(file_handle_), out + total, to_read, &read, &overlapped))
+            throw std::runtime_error("PreadReader::" + caller + ": Error while reading file.");
+#else
+        ssize_t read = pread(fd_, out + total, size - total, static_cast<off_t>(offset + total));
+        if (read < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            throw std::runtime_error("PreadReader::" + caller + ": Error while reading file.");
+        }
+#endif
+        if (read == 0)
+            throw std::runtime_error("PreadReader::" + caller + ": Requested range is outside of the file.");
+        total += static_cast<size_t>(read);
+    }
+}
+
+std::vector<Entry> PreadReader::ReadPage(std::shared_ptr<Internal::PageInternal> page)
+{
+    std::vector<Entry> out;
+    if (!page->IsValid())
+        throw std::runtime_error("PreadReader::ReadPage: Cannot load an invalid page.");
+
+    std::vector<char> page_data(page->byte_size);
+    ReadAt(page->offset, page_data.data(), page_data.size(), "ReadPage");
+
+    out = ParsePage(page_data.data(), page->byte_size);
+    page->loaded = true;
+    return out;
+}
+
+void PreadReader::ReadFileBytes(uint64_t offset, char *out, size_t size) { ReadAt(offset, out, size, "ReadFileBytes"); }
+
+std::vector<char> PreadReader::GetPointDataCompressed(Node const &node)
+{
+    if (!node.IsValid())
+        throw std::runtime_error("PreadReader::GetPointDataCompressed: Cannot load an invalid node.");
+
+    std::vector<char> out(node.byte_size);
+    ReadAt(node.offset, out.data(), out.size(), "GetPointDataCompressed");
+    return out;
+}
+
+} // namespace copc
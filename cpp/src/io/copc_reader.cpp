@@ -1,12 +1,19 @@
+#include <algorithm>
 #include <cmath>
+#include <cstring>
+#include <future>
 #include <iomanip>
 #include <iostream>
+#include <mutex>
+#include <optional>
 #include <stdexcept>
 
 #include "copc-lib/copc/copc_config.hpp"
 #include "copc-lib/copc/extents.hpp"
 #include "copc-lib/hierarchy/internal/hierarchy.hpp"
 #include "copc-lib/io/copc_reader.hpp"
+#include "copc-lib/io/internal/node_cache.hpp"
+#include "copc-lib/io/internal/thread_pool.hpp"
 #include "copc-lib/laz/decompressor.hpp"
 
 #include <lazperf/vlr.hpp>
@@ -73,50 +80,344 @@ std::vector<Entry> Reader::ReadPage(std::shared_ptr<Internal::PageInternal> page
     if (!page->IsValid())
         throw std::runtime_error("Reader::ReadPage: Cannot load an invalid page.");
 
-    // reset the stream to the page's offset
-    in_stream_->seekg(page->offset);
+    // Read the whole page at once, and parse it from memory
+    std::vector<char> page_data(page->byte_size);
+    ReadFileBytes(page->offset, page_data.data(), page_data.size());
 
-    // Iterate through each Entry in the page
-    int num_entries = int(page->byte_size / Entry::ENTRY_SIZE);
-    for (int i = 0; i < num_entries; i++)
+    out = ParsePage(page_data.data(), page->byte_size);
+    page->loaded = true;
+    return out;
+}
+
+void Reader::ReadFileBytes(uint64_t offset, char *out, size_t size)
+{
+    std::lock_guard<std::mutex> lock(stream_mutex_);
+    if (in_stream_ == nullptr)
+        throw std::runtime_error("Reader::ReadFileBytes: Reader has no stream to read from.");
+    in_stream_->seekg(offset);
+    in_stream_->read(out, size);
+    if (!in_stream_->good())
     {
-        Entry e = Entry::Unpack(*in_stream_);
-        if (!e.IsValid())
-            throw std::runtime_error("Entry is invalid! " + e.ToString());
+        in_stream_->clear();
+        throw std::runtime_error("Reader::ReadFileBytes: Requested range is outside of the file.");
+    }
+}
+
+std::vector<Entry> Reader::ParsePage(const char *page_data, int32_t byte_size)
+{
+    if (byte_size < 0)
+        throw std::runtime_error("Reader::ParsePage: Invalid page size.");
+    return Entry::UnpackEntries(page_data, static_cast<size_t>(byte_size));
+}
 
-        out.push_back(e);
+void Reader::LoadHierarchy(unsigned int num_threads)
+{
+    // The hierarchy is only locked to add parsed pages, so lookups on other threads go on while the EVLR is read and
+    // parsed. Pages that another thread loads meanwhile are skipped
+    std::vector<std::shared_ptr<Internal::PageInternal>> pages;
+    {
+        std::lock_guard<std::recursive_mutex> lock(hierarchy_->mutex_);
+        if (hierarchy_->FullyLoaded())
+            return;
+        for (const auto &seen_page : hierarchy_->seen_pages_)
+        {
+            if (!seen_page.second->loaded)
+                pages.push_back(seen_page.second);
+        }
     }
 
-    page->loaded = true;
-    return out;
+    // Every page lives in the hierarchy EVLR, so a single read gets all of them
+    auto vlr_offset = FetchVlr(vlrs_, "copc", 1000);
+    const auto &vlr = vlrs_.at(vlr_offset);
+    uint64_t data_offset = vlr_offset + (vlr.evlr_flag ? las::EVLR_HEADER_SIZE : las::VLR_HEADER_SIZE);
+    std::vector<char> data(vlr.data_length);
+    ReadFileBytes(data_offset, data.data(), data.size());
+    {
+        // The EVLR holds at most this many nodes, so the node index never needs to grow
+        std::lock_guard<std::recursive_mutex> lock(hierarchy_->mutex_);
+        hierarchy_->node_index_.Reserve(data.size() / Entry::ENTRY_SIZE);
+    }
+
+    auto parse_page = [this, &data, data_offset](const std::shared_ptr<Internal::PageInternal> &page)
+    {
+        if (!page->IsValid())
+            throw std::runtime_error("Reader::LoadHierarchy: Cannot load an invalid page.");
+        auto page_offset = static_cast<uint64_t>(page->offset);
+        auto page_size = static_cast<uint64_t>(page->byte_size);
+        // Files that put pages outside of the EVLR aren't valid COPC, but can still be read page by page
+        if (page_offset < data_offset || page_offset - data_offset + page_size > data.size())
+        {
+            std::vector<char> page_data(page_size);
+            ReadFileBytes(page_offset, page_data.data(), page_data.size());
+            return ParsePage(page_data.data(), page->byte_size);
+        }
+        return ParsePage(data.data() + (page_offset - data_offset), page->byte_size);
+    };
+
+    if (num_threads == 0)
+        num_threads = Internal::ThreadPool::DefaultThreadCount();
+    std::shared_ptr<Internal::ThreadPool> pool;
+    if (num_threads > 1)
+        pool = GetThreadPool(num_threads);
+
+    // Parse the page tree one level at a time, since a page's subpages are only known once it's parsed
+    while (!pages.empty())
+    {
+        std::vector<std::vector<Entry>> entries(pages.size());
+        if (pool == nullptr || pages.size() == 1)
+        {
+            for (size_t i = 0; i < pages.size(); i++)
+                entries[i] = parse_page(pages[i]);
+        }
+        else
+        {
+            pool->ForEach(pages.size(), num_threads, [&](size_t i) { entries[i] = parse_page(pages[i]); });
+        }
+
+        std::vector<std::shared_ptr<Internal::PageInternal>> sub_pages;
+        std::lock_guard<std::recursive_mutex> lock(hierarchy_->mutex_);
+        for (size_t i = 0; i < pages.size(); i++)
+        {
+            if (!pages[i]->loaded)
+            {
+                pages[i]->loaded = true;
+                AddPageEntries(pages[i], entries[i]);
+            }
+            for (const auto &sub_page : pages[i]->sub_pages)
+            {
+                if (!sub_page->loaded)
+                    sub_pages.push_back(sub_page);
+            }
+        }
+        pages = std::move(sub_pages);
+    }
 }
 
 las::Points Reader::GetPoints(Node const &node)
 {
-    std::vector<char> point_data = GetPointData(node);
-    return las::Points::Unpack(point_data, config_.LasHeader());
+    auto point_data = LoadPointData(node);
+    return las::Points::Unpack(*point_data, config_.LasHeader());
 }
 
 las::Points Reader::GetPoints(VoxelKey const &key)
 {
-    std::vector<char> point_data = GetPointData(key);
+    if (!key.IsValid())
+        return las::Points(config_.LasHeader());
 
-    if (point_data.empty())
+    auto node = FindNode(key);
+    if (!node.IsValid())
         return las::Points(config_.LasHeader());
 
-    return las::Points::Unpack(point_data, config_.LasHeader());
+    return GetPoints(node);
+}
+
+las::PointBuffer Reader::GetPointBuffer(Node const &node, uint32_t dimensions)
+{
+    auto point_data = LoadPointData(node);
+    return las::PointBuffer::Unpack(*point_data, config_.LasHeader(), dimensions);
+}
+
+las::PointBuffer Reader::GetPointBuffer(VoxelKey const &key, uint32_t dimensions)
+{
+    if (!key.IsValid())
+        return las::PointBuffer(config_.LasHeader(), dimensions);
+
+    auto node = FindNode(key);
+    if (!node.IsValid())
+        return las::PointBuffer(config_.LasHeader(), dimensions);
+
+    return GetPointBuffer(node, dimensions);
+}
+
+template <typename T, typename F>
+std::vector<T> Reader::DecodeNodes(const std::vector<Node> &nodes, unsigned int num_threads, const F &decode)
+{
+    std::vector<T> out;
+    out.reserve(nodes.size());
+
+    if (num_threads == 0)
+        num_threads = Internal::ThreadPool::DefaultThreadCount();
+
+    // No point in handing the work off to another thread
+    if (num_threads == 1 || nodes.size() <= 1)
+    {
+        for (const auto &node : nodes)
+            out.push_back(decode(node));
+        return out;
+    }
+
+    // Slots are filled in any order, and then moved out in the order of `nodes`
+    std::vector<std::optional<T>> results(nodes.size());
+    GetThreadPool(num_threads)->ForEach(nodes.size(), num_threads,
+                                        [&](size_t i) { results[i].emplace(decode(nodes[i])); });
+    for (auto &result : results)
+        out.push_back(std::move(*result));
+    return out;
+}
+
+std::vector<las::Points> Reader::GetPoints(const std::vector<Node> &nodes, unsigned int num_threads)
+{
+    return DecodeNodes<las::Points>(nodes, num_threads, [this](const Node &node) { return GetPoints(node); });
+}
+
+std::vector<las::PointBuffer> Reader::GetPointBuffers(const std::vector<Node> &nodes, uint32_t dimensions,
+                                                      unsigned int num_threads)
+{
+    return DecodeNodes<las::PointBuffer>(nodes, num_threads,
+                                         [this, dimensions](const Node &node)
+                                         { return GetPointBuffer(node, dimensions); });
+}
+
+void Reader::GetPoints(const std::vector<Node> &nodes, const std::function<void(const Node &, las::Points &)> &callback,
+                       unsigned int num_threads)
+{
+    if (num_threads == 0)
+        num_threads = Internal::ThreadPool::DefaultThreadCount();
+
+    if (num_threads == 1 || nodes.size() <= 1)
+    {
+        for (const auto &node : nodes)
+        {
+            auto points = GetPoints(node);
+            callback(node, points);
+        }
+        return;
+    }
+
+    // Nodes are decoded on the pool, and handed to the callback on this thread as they complete
+    GetThreadPool(num_threads)->ForEachCompleted(
+        nodes.size(), num_threads, [&](size_t i) { return GetPoints(nodes[i]); },
+        [&](size_t i, las::Points &points) { callback(nodes[i], points); });
+}
+
+std::shared_ptr<Internal::ThreadPool> Reader::GetThreadPool(unsigned int num_threads)
+{
+    std::lock_guard<std::mutex> lock(thread_pool_mutex_);
+    // The pool is only ever grown, so that batches asking for different thread counts share its workers
+    auto size = std::max<size_t>(num_threads, Internal::ThreadPool::DefaultThreadCount());
+    if (thread_pool_ == nullptr)
+        thread_pool_ = std::make_shared<Internal::ThreadPool>(size);
+    else
+        thread_pool_->Grow(size);
+    return thread_pool_;
 }
 
 std::vector<char> Reader::GetPointData(Node const &node)
+{
+    std::vector<char> point_data;
+    GetPointData(node, point_data);
+    return point_data;
+}
+
+void Reader::GetPointData(Node const &node, std::vector<char> &out)
 {
     if (!node.IsValid())
         throw std::runtime_error("Reader::GetPointData: Cannot load an invalid node.");
 
-    in_stream_->seekg(node.offset);
+    out.resize(PointDataSize(node));
+    GetPointData(node, out.data(), out.size());
+}
 
-    auto las_header = config_.LasHeader();
-    std::vector<char> point_data = laz::Decompressor::DecompressBytes(*in_stream_, las_header, node.point_count);
-    return point_data;
+void Reader::GetPointData(Node const &node, char *out, size_t out_size)
+{
+    if (!node.IsValid())
+        throw std::runtime_error("Reader::GetPointData: Cannot load an invalid node.");
+
+    // Without a cache, decompress straight into `out`
+    if (GetNodeCache() == nullptr)
+    {
+        ReadPointData(node, out, out_size);
+        return;
+    }
+
+    auto data = LoadPointData(node);
+    if (out_size < data->size())
+        throw std::runtime_error("Reader::GetPointData: Output buffer of " + std::to_string(out_size) +
+                                 " bytes is too small to hold " + std::to_string(data->size()) + " bytes.");
+    std::memcpy(out, data->data(), data->size());
+}
+
+void Reader::ReadPointData(Node const &node, char *out, size_t out_size)
+{
+    if (!node.IsValid())
+        throw std::runtime_error("Reader::GetPointData: Cannot load an invalid node.");
+
+    // ReadFileBytes only holds the stream while reading, so that other threads can read while this one decompresses
+    std::vector<char> compressed_data(node.byte_size);
+    ReadFileBytes(node.offset, compressed_data.data(), compressed_data.size());
+
+    DecompressNode(node, compressed_data.data(), compressed_data.size(), out, out_size);
+}
+
+void Reader::DecompressNode(const Node &node, const char *compressed_data, size_t compressed_size, char *out,
+                            size_t out_size) const
+{
+    laz::Decompressor::DecompressBytes(compressed_data, compressed_size, config_.LasHeader(), node.point_count, out,
+                                       out_size);
+}
+
+std::shared_ptr<const std::vector<char>> Reader::LoadPointData(Node const &node)
+{
+    if (!node.IsValid())
+        throw std::runtime_error("Reader::GetPointData: Cannot load an invalid node.");
+
+    auto cache = GetNodeCache();
+    if (cache != nullptr)
+    {
+        if (auto data = cache->Get(node.key))
+            return data;
+    }
+
+    auto data = std::make_shared<std::vector<char>>(PointDataSize(node));
+    ReadPointData(node, data->data(), data->size());
+    if (cache != nullptr)
+        cache->Put(node.key, data);
+    return data;
+}
+
+void Reader::EnableNodeCache(size_t max_bytes)
+{
+    std::lock_guard<std::mutex> lock(node_cache_mutex_);
+    if (max_bytes == 0)
+        node_cache_ = nullptr;
+    else
+        node_cache_ = std::make_shared<Internal::NodeCache>(max_bytes);
+}
+
+void Reader::ClearNodeCache()
+{
+    auto cache = GetNodeCache();
+    if (cache != nullptr)
+        cache->Clear();
+}
+
+NodeCacheStats Reader::GetNodeCacheStats() const
+{
+    NodeCacheStats stats;
+    auto cache = GetNodeCache();
+    if (cache == nullptr)
+        return stats;
+
+    stats.hits = cache->Hits();
+    stats.misses = cache->Misses();
+    stats.evictions = cache->Evictions();
+    stats.node_count = cache->NodeCount();
+    stats.bytes = cache->Bytes();
+    stats.max_bytes = cache->MaxBytes();
+    return stats;
+}
+
+std::shared_ptr<Internal::NodeCache> Reader::GetNodeCache() const
+{
+    std::lock_guard<std::mutex> lock(node_cache_mutex_);
+    return node_cache_;
+}
+
+size_t Reader::PointDataSize(Node const &node) const
+{
+    if (!node.IsValid())
+        return 0;
+    return static_cast<size_t>(node.point_count) * config_.LasHeader().PointRecordLength();
 }
 
 std::vector<char> Reader::GetPointData(VoxelKey const &key)
@@ -137,11 +438,8 @@ std::vector<char> Reader::GetPointDataCompressed(Node const &node)
     if (!node.IsValid())
         throw std::runtime_error("Reader::GetPointDataCompressed: Cannot load an invalid node.");
 
-    in_stream_->seekg(node.offset);
-
-    std::vector<char> out;
-    out.resize(node.byte_size);
-    in_stream_->read(&out[0], node.byte_size);
+    std::vector<char> out(node.byte_size);
+    ReadFileBytes(node.offset, out.data(), out.size());
     return out;
 }
 
@@ -164,6 +462,12 @@ std::vector<Node> Reader::GetAllChildrenOfPage(const VoxelKey &key)
     if (!key.IsValid())
         return out;
 
+    // The whole hierarchy is needed, so read it in one go rather than page by page
+    if (key == VoxelKey::RootKey())
+        LoadHierarchy();
+
+    std::lock_guard<std::recursive_mutex> lock(hierarchy_->mutex_);
+
     // Load all pages upto the current key
     auto node = FindNode(key);
     // If a page with this key doesn't exist, check if the node itself exists and return it
@@ -176,6 +480,8 @@ std::vector<Node> Reader::GetAllChildrenOfPage(const VoxelKey &key)
 
     // If the page does exist, we need to read all its children and subpages into memory recursively
     LoadPageHierarchy(hierarchy_->seen_pages_[key], out);
+    for (auto &child : out)
+        AttachNodeStats(child);
     return out;
 }
 
@@ -184,6 +490,7 @@ std::vector<VoxelKey> Reader::GetPageList()
     // Load all nodes and pages in hierarchy
     GetAllNodes();
 
+    std::lock_guard<std::recursive_mutex> lock(hierarchy_->mutex_);
     std::vector<VoxelKey> page_keys;
     page_keys.reserve(hierarchy_->seen_pages_.size());
 
@@ -194,16 +501,12 @@ std::vector<VoxelKey> Reader::GetPageList()
     return page_keys;
 }
 
-las::Points Reader::GetAllPoints(double resolution)
+las::Points Reader::GetAllPoints(double resolution, unsigned int num_threads)
 {
     auto out = las::Points(config_.LasHeader());
 
-    auto max_depth = GetDepthAtResolution(resolution);
-
-    // Get all nodes in octree
-    for (const auto &node : GetAllNodes())
-        if (node.key.d <= max_depth)
-            out.AddPoints(GetPoints(node));
+    for (const auto &points : GetPoints(GetNodesWithinResolution(resolution), num_threads))
+        out.AddPoints(points);
     return out;
 }
 
@@ -211,11 +514,10 @@ std::vector<Node> Reader::GetNodesWithinBox(const Box &box, double resolution)
 {
     std::vector<Node> out;
 
-    auto max_depth = GetDepthAtResolution(resolution);
-
-    for (const auto &node : GetAllNodes())
+    // A node can only be within the box if all its ancestors intersect it
+    for (const auto &node : GetNodesIntersectBox(box, resolution))
     {
-        if (node.key.Within(config_.LasHeader(), box) && node.key.d <= max_depth)
+        if (node.key.Within(config_.LasHeader(), box))
             out.push_back(node);
     }
 
@@ -226,72 +528,172 @@ std::vector<Node> Reader::GetNodesIntersectBox(const Box &box, double resolution
 {
     std::vector<Node> out;
 
-    auto max_depth = GetDepthAtResolution(resolution);
+    auto max_depth = GetQueryDepthAtResolution(resolution);
 
-    // Get all nodes in octree
-    for (const auto &node : GetAllNodes())
-    {
-        if (node.key.Intersects(config_.LasHeader(), box) && node.key.d <= max_depth)
-            out.push_back(node);
-    }
+    // Walk down the octree from the root, only loading the pages we need
+    CollectNodesIntersectBox(VoxelKey::RootKey(), box, max_depth, out);
 
     return out;
 }
 
-las::Points Reader::GetPointsWithinBox(const Box &box, double resolution)
+void Reader::CollectNodesIntersectBox(const VoxelKey &key, const Box &box, int32_t max_depth, std::vector<Node> &out)
+{
+    if (key.d > max_depth || !key.Intersects(config_.LasHeader(), box))
+        return;
+
+    // FindNode loads the page that holds the key, which makes the index know about everything under the key
+    auto node = FindNode(key);
+    if (node.IsValid())
+        out.push_back(node);
+    if (key.d >= max_depth)
+        return;
+
+    // Writers don't have to add a node's ancestors, so children are descended into as long as any node or subpage
+    // lies under them, whether or not the key is a node itself
+    for (const auto &child : key.GetChildren())
+    {
+        bool has_subtree;
+        {
+            std::lock_guard<std::recursive_mutex> lock(hierarchy_->mutex_);
+            has_subtree = hierarchy_->node_index_.HasSubtree(child);
+        }
+        if (has_subtree)
+            CollectNodesIntersectBox(child, box, max_depth, out);
+    }
+}
+
+las::Points Reader::GetPointsWithinBox(const Box &box, double resolution, unsigned int num_threads)
 {
-    auto max_depth = GetDepthAtResolution(resolution);
     auto out = las::Points(config_.LasHeader());
 
-    // Get all nodes in octree
-    for (const auto &node : GetAllNodes())
+    auto nodes = GetNodesIntersectBox(box, resolution);
+
+    auto node_points = GetPoints(nodes, num_threads);
+    for (size_t i = 0; i < nodes.size(); i++)
     {
-        if (node.key.d <= max_depth)
+        // If node fits in Box
+        if (nodes[i].key.Within(config_.LasHeader(), box))
         {
-            // If node fits in Box
-            if (node.key.Within(config_.LasHeader(), box))
-            {
-                // If the node is within the box add all points
-                out.AddPoints(GetPoints(node));
-            }
-            else if (node.key.Intersects(config_.LasHeader(), box))
-            {
-                // If the node only crosses the box then get subset of points within box
-                auto points = GetPoints(node);
-                out.AddPoints(points.GetWithin(box));
-            }
+            // If the node is within the box add all points
+            out.AddPoints(node_points[i]);
+        }
+        else
+        {
+            // If the node only crosses the box then get subset of points within box
+            out.AddPoints(node_points[i].GetWithin(box));
         }
     }
     return out;
 }
 
-int32_t Reader::GetDepthAtResolution(double resolution)
+PointCursor Reader::QueryPointsWithinBox(const Box &box, double resolution, unsigned int prefetch)
 {
-    // Compute max depth
-    int32_t max_depth = -1;
-    // Get all nodes in octree
-    for (const auto &node : GetAllNodes())
+    return PointCursor(this, GetNodesIntersectBox(box, resolution), box, prefetch);
+}
+
+PointCursor::PointCursor(Reader *reader, std::vector<Node> nodes, const Box &box, unsigned int prefetch)
+    : reader_(reader), header_(std::make_shared<las::LasHeader>(reader->config_.LasHeader())), nodes_(std::move(nodes)),
+      box_(box), prefetch_(prefetch)
+{
+    // The reader's pool is shared as it is, Prefetch keeps at most prefetch_ of the cursor's nodes in flight on it
+    if (prefetch_ > 0 && !nodes_.empty())
+        pool_ = reader_->GetThreadPool();
+}
+
+PointCursor::~PointCursor()
+{
+    for (auto &future : pending_)
+        future.wait();
+}
+
+bool PointCursor::Next(las::Points &out)
+{
+    while (next_read_ < nodes_.size())
     {
-        if (node.key.d > max_depth)
-            max_depth = node.key.d;
+        const auto &node = nodes_[next_read_];
+        las::Points points(*header_);
+        if (pool_ == nullptr)
+        {
+            points = DecodeNode(reader_, header_, box_, node);
+            next_read_++;
+        }
+        else
+        {
+            Prefetch();
+            auto future = std::move(pending_.front());
+            pending_.pop_front();
+            next_read_++;
+            points = future.get();
+        }
+
+        if (points.Size() == 0)
+            continue;
+        current_node_ = node;
+        out = std::move(points);
+        return true;
     }
+    return false;
+}
 
-    // If query resolution is <=0 return the octree's max depth
+las::Points PointCursor::DecodeNode(Reader *reader, const std::shared_ptr<const las::LasHeader> &header,
+                                    const Box &box, const Node &node)
+{
+    auto points = reader->GetPoints(node);
+    if (node.key.Within(*header, box))
+        return points;
+
+    // If the node only crosses the box then get subset of points within box
+    las::Points within(*header);
+    within.AddPoints(points.GetWithin(box));
+    return within;
+}
+
+void PointCursor::Prefetch()
+{
+    while (next_queued_ < nodes_.size() && next_queued_ < next_read_ + prefetch_)
+    {
+        pending_.push_back(pool_->Submit([reader = reader_, header = header_, box = box_, node = nodes_[next_queued_]]
+                                         { return DecodeNode(reader, header, box, node); }));
+        next_queued_++;
+    }
+}
+
+int32_t Reader::GetQueryDepthAtResolution(double resolution) const
+{
+    // If query resolution is <=0 there is no depth limit
     if (resolution <= 0.0)
-        return max_depth;
+        return std::numeric_limits<int32_t>::max();
 
+    // Same as GetDepthAtResolution, except that we don't clamp to the octree's max depth,
+    // since that would require loading the whole hierarchy
     auto current_resolution = config_.CopcInfo().spacing;
-
-    for (int32_t i = 0; i <= max_depth; i++)
+    int32_t depth = 0;
+    while (current_resolution > resolution && depth < std::numeric_limits<int32_t>::max())
     {
-        if (current_resolution <= resolution)
-            return i;
         current_resolution /= 2;
+        depth++;
     }
-    return max_depth;
+    return depth;
 }
 
-int32_t Reader::GetMaxDepth() { return GetDepthAtResolution(-1); }
+int32_t Reader::GetDepthAtResolution(double resolution)
+{
+    auto max_depth = GetMaxDepth();
+
+    // If query resolution is <=0 return the octree's max depth
+    if (resolution <= 0.0)
+        return max_depth;
+
+    return std::min(GetQueryDepthAtResolution(resolution), max_depth);
+}
+
+int32_t Reader::GetMaxDepth()
+{
+    // The max depth is tracked as pages get parsed, so we only need to load the whole hierarchy once
+    LoadHierarchy();
+    std::lock_guard<std::recursive_mutex> lock(hierarchy_->mutex_);
+    return hierarchy_->max_loaded_depth_;
+}
 
 std::vector<Node> Reader::GetNodesAtResolution(double resolution)
 {
@@ -299,7 +701,7 @@ std::vector<Node> Reader::GetNodesAtResolution(double resolution)
 
     std::vector<Node> out;
 
-    for (const auto &node : GetAllNodes())
+    for (const auto &node : GetNodesWithinResolution(resolution))
     {
         if (node.key.d == target_depth)
             out.push_back(node);
@@ -310,15 +712,10 @@ std::vector<Node> Reader::GetNodesAtResolution(double resolution)
 
 std::vector<Node> Reader::GetNodesWithinResolution(double resolution)
 {
-    auto target_depth = GetDepthAtResolution(resolution);
-
     std::vector<Node> out;
 
-    for (const auto &node : GetAllNodes())
-    {
-        if (node.key.d <= target_depth)
-            out.push_back(node);
-    }
+    // Only the pages above the target depth need to be loaded
+    CollectNodesIntersectBox(VoxelKey::RootKey(), Box::MaxBox(), GetQueryDepthAtResolution(resolution), out);
 
     return out;
 }
@@ -408,4 +805,104 @@ bool Reader::ValidateSpatialBounds(bool verbose)
     return is_valid;
 }
 
+std::shared_ptr<const std::unordered_map<VoxelKey, NodeStats>> Reader::LoadNodeStats()
+{
+    std::lock_guard<std::mutex> lock(node_stats_mutex_);
+    if (node_stats_loaded_)
+        return node_stats_;
+
+    auto offset = FetchVlr(vlrs_, NodeStats::VLR_USER_ID, NodeStats::VLR_RECORD_ID);
+    if (offset == 0)
+    {
+        node_stats_ = std::make_shared<std::unordered_map<VoxelKey, NodeStats>>();
+    }
+    else
+    {
+        const auto &vlr = vlrs_.at(offset);
+        std::vector<char> data(vlr.data_length);
+        ReadFileBytes(offset + (vlr.evlr_flag ? las::EVLR_HEADER_SIZE : las::VLR_HEADER_SIZE), data.data(),
+                      data.size());
+        node_stats_ = std::make_shared<std::unordered_map<VoxelKey, NodeStats>>(NodeStats::UnpackNodes(data));
+    }
+    node_stats_loaded_ = true;
+    return node_stats_;
+}
+
+void Reader::AttachNodeStats(Node &node)
+{
+    auto node_stats = LoadNodeStats();
+    auto it = node_stats->find(node.key);
+    // The map is never modified once loaded, so the node can point into it
+    if (it != node_stats->end())
+        node.stats = std::shared_ptr<const NodeStats>(node_stats, &it->second);
+}
+
+Node Reader::FindNode(VoxelKey key)
+{
+    auto node = BaseIO::FindNode(key);
+    if (node.IsValid())
+        AttachNodeStats(node);
+    return node;
+}
+
+bool Reader::HasNodeStats() { return !LoadNodeStats()->empty(); }
+
+bool Reader::GetNodeStats(const VoxelKey &key, NodeStats &out)
+{
+    auto node_stats = LoadNodeStats();
+    auto it = node_stats->find(key);
+    if (it == node_stats->end())
+        return false;
+    out = it->second;
+    return true;
+}
+
+std::vector<Node> Reader::GetNodesWithFilter(const PointFilter &filter, const Box &box, double resolution)
+{
+    auto nodes = GetNodesIntersectBox(box, resolution);
+    if (filter.Empty())
+        return nodes;
+
+    // The nodes found by the box query carry their stats
+    std::vector<Node> out;
+    out.reserve(nodes.size());
+    for (const auto &node : nodes)
+    {
+        if (!node.stats || filter.MayMatch(*node.stats))
+            out.push_back(node);
+    }
+    return out;
+}
+
+las::PointBuffer Reader::GetPointsWithFilter(const PointFilter &filter, const Box &box, double resolution,
+                                             uint32_t dimensions, unsigned int num_threads)
+{
+    auto header = config_.LasHeader();
+    auto nodes = GetNodesWithFilter(filter, box, resolution);
+
+    // Nodes that only cross the box need their XYZ to be tested against it
+    auto crosses_box = [&header, &box](const Node &node) { return !node.key.Within(header, box); };
+    dimensions |= filter.RequiredDimensions();
+    if (std::any_of(nodes.begin(), nodes.end(), crosses_box))
+        dimensions |= las::Dimension::DIM_XYZ;
+
+    auto buffers = DecodeNodes<las::PointBuffer>(nodes, num_threads,
+                                                 [this, &crosses_box, &filter, &box, dimensions](const Node &node)
+                                                 {
+                                                     auto points = GetPointBuffer(node, dimensions);
+                                                     if (crosses_box(node))
+                                                         points = points.GetWithin(box);
+                                                     return filter.Apply(points);
+                                                 });
+
+    las::PointBuffer out(header, dimensions);
+    size_t point_count = 0;
+    for (const auto &points : buffers)
+        point_count += points.Size();
+    out.Reserve(point_count);
+    for (const auto &points : buffers)
+        out.AddPoints(points);
+    return out;
+}
+
 } // namespace copc
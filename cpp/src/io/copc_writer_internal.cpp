@@ -7,6 +7,8 @@
 #include "copc-lib/copc/extents.hpp"
 #include "copc-lib/hierarchy/internal/hierarchy.hpp"
 #include "copc-lib/io/internal/copc_writer_internal.hpp"
+#include "copc-lib/laz/compressor.hpp"
+#include "copc-lib/laz/decompressor.hpp"
 
 #include <lazperf/lazperf.hpp>
 #include <lazperf/vlr.hpp>
@@ -42,11 +44,31 @@ WriterInternal::WriterInternal(std::ostream &out_stream, const std::shared_ptr<C
     std::fill_n(std::ostream_iterator<char>(out_stream_), FirstChunkOffset(), 0);
 }
 
+WriterInternal::~WriterInternal()
+{
+    // Destructors mustn't throw
+    try
+    {
+        Close();
+    }
+    catch (...)
+    {
+    }
+}
+
 void WriterInternal::Close()
 {
     if (!open_)
         return;
 
+    // Every queued node must be in the file before the chunk table and hierarchy are written
+    StopPipeline();
+    if (pipeline_error_)
+    {
+        open_ = false;
+        std::rethrow_exception(pipeline_error_);
+    }
+
     WriteChunkTable();
 
     // Set COPC hierarchy evlr
@@ -60,8 +82,18 @@ void WriterInternal::Close()
     // has to write the offset of all of its children, which we don't know in advance
     WritePageTree(hierarchy_->seen_pages_[VoxelKey::RootKey()]);
 
+    WriteNodeStats();
+
     WriteWKT();
 
+    // Every node has been analyzed once the pipeline is stopped
+    if (auto_extents_)
+    {
+        auto extents = AccumulatedExtents();
+        extents.ApplyBounds(*GetConfig()->LasHeader());
+        extents.Apply(*GetConfig()->CopcExtents());
+    }
+
     WriteHeader();
 
     open_ = false;
@@ -116,6 +148,201 @@ Entry WriterInternal::WriteNode(const std::vector<char> &in, int32_t point_count
     return entry;
 }
 
+void WriterInternal::StartPipeline(size_t num_threads, size_t max_bytes_in_flight)
+{
+    if (num_threads == 0)
+        num_threads = ThreadPool::DefaultThreadCount();
+
+    // Restarting with a different number of threads must not reorder the nodes already queued
+    StopPipeline();
+    if (pipeline_error_)
+        std::rethrow_exception(pipeline_error_);
+
+    compress_pool_ = std::make_unique<ThreadPool>(num_threads);
+    max_bytes_in_flight_ = max_bytes_in_flight;
+    stopping_ = false;
+    committer_ = std::thread([this] { CommitLoop(); });
+}
+
+void WriterInternal::QueueNode(const std::shared_ptr<Node> &node, std::vector<char> in, bool compressed,
+                               std::promise<Node> written)
+{
+    if (!Pipelined())
+        throw std::runtime_error("WriterInternal::QueueNode: The compression pipeline isn't running.");
+
+    auto point_format_id = GetConfig()->LasHeader()->PointFormatId();
+    auto eb_byte_size = GetConfig()->LasHeader()->EbByteSize();
+
+    // Nodes are analyzed on the workers, compressed data is decompressed there too
+    std::shared_ptr<std::shared_ptr<const NodeStats>> stats;
+    if (AnalyzesNodes())
+        stats = std::make_shared<std::shared_ptr<const NodeStats>>();
+
+    {
+        // A node larger than the budget is still let through once the pipeline is empty
+        std::unique_lock<std::mutex> lock(pipeline_mutex_);
+        committed_cv_.wait(lock,
+                           [&]
+                           {
+                               return bytes_in_flight_ == 0 || bytes_in_flight_ + in.size() <= max_bytes_in_flight_ ||
+                                      pipeline_error_;
+                           });
+        if (pipeline_error_)
+            std::rethrow_exception(pipeline_error_);
+
+        PendingNode pending;
+        pending.node = node;
+        pending.byte_size = in.size();
+        pending.written = std::move(written);
+        pending.stats = stats;
+        if (compressed && stats)
+        {
+            pending.compressed_data = compress_pool_->Submit(
+                [this, in = std::move(in), key = node->key, point_count = node->point_count, stats]() mutable
+                {
+                    *stats = AnalyzeNode(key, in, true, point_count);
+                    return std::move(in);
+                });
+        }
+        else if (compressed)
+        {
+            std::promise<std::vector<char>> ready;
+            ready.set_value(std::move(in));
+            pending.compressed_data = ready.get_future();
+        }
+        else
+        {
+            pending.compressed_data = compress_pool_->Submit(
+                [this, in = std::move(in), key = node->key, stats, point_format_id, eb_byte_size]
+                {
+                    if (stats)
+                        *stats = AnalyzeNode(key, in, false, 0);
+                    return laz::Compressor::CompressBytes(in, point_format_id, eb_byte_size);
+                });
+        }
+        bytes_in_flight_ += pending.byte_size;
+        in_flight_++;
+        pending_nodes_.push_back(std::move(pending));
+    }
+    queued_cv_.notify_one();
+}
+
+void WriterInternal::Flush()
+{
+    std::unique_lock<std::mutex> lock(pipeline_mutex_);
+    committed_cv_.wait(lock, [this] { return in_flight_ == 0; });
+    if (pipeline_error_)
+        std::rethrow_exception(pipeline_error_);
+}
+
+// Writes the queued nodes in order, waiting on each one's compression to finish
+void WriterInternal::CommitLoop()
+{
+    while (true)
+    {
+        PendingNode pending;
+        {
+            std::unique_lock<std::mutex> lock(pipeline_mutex_);
+            queued_cv_.wait(lock, [this] { return stopping_ || !pending_nodes_.empty(); });
+            if (pending_nodes_.empty())
+                return;
+            pending = std::move(pending_nodes_.front());
+            pending_nodes_.pop_front();
+        }
+
+        std::exception_ptr error;
+        try
+        {
+            auto compressed_data = pending.compressed_data.get();
+            // Once a node has failed, the following ones are dropped
+            if (pipeline_error_)
+                std::rethrow_exception(pipeline_error_);
+
+            uint64_t offset;
+            int32_t byte_size;
+            WriteChunk(compressed_data, pending.node->point_count, true, &offset, &byte_size);
+
+            Node written;
+            {
+                std::lock_guard<std::recursive_mutex> hierarchy_lock(hierarchy_->mutex_);
+                pending.node->offset = offset;
+                pending.node->byte_size = byte_size;
+                // The worker is done with the stats, since its compressed data is ready
+                if (pending.stats)
+                    pending.node->stats = *pending.stats;
+                written = *pending.node;
+            }
+            pending.written.set_value(written);
+        }
+        catch (...)
+        {
+            error = std::current_exception();
+            pending.written.set_exception(error);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(pipeline_mutex_);
+            if (error && !pipeline_error_)
+                pipeline_error_ = error;
+            bytes_in_flight_ -= pending.byte_size;
+            in_flight_--;
+        }
+        committed_cv_.notify_all();
+    }
+}
+
+void WriterInternal::StopPipeline()
+{
+    if (!Pipelined())
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(pipeline_mutex_);
+        stopping_ = true;
+    }
+    queued_cv_.notify_all();
+    // The committer drains the queue before returning
+    committer_.join();
+    compress_pool_.reset();
+}
+
+std::shared_ptr<const NodeStats> WriterInternal::AnalyzeNode(const VoxelKey &key, const std::vector<char> &in,
+                                                             bool compressed, int32_t point_count)
+{
+    const auto &header = *GetConfig()->LasHeader();
+    // Stats and extents are computed on the values as they're stored, so they match what readers decode
+    std::vector<char> uncompressed;
+    if (compressed)
+        uncompressed = laz::Decompressor::DecompressBytes(in.data(), in.size(), header, point_count);
+    auto points = las::PointBuffer::Unpack(compressed ? uncompressed : in, header);
+
+    if (auto_extents_)
+        AccumulateExtents(points);
+    if (!node_stats_enabled_)
+        return nullptr;
+
+    auto stats = std::make_shared<const NodeStats>(NodeStats::FromPoints(points));
+    std::lock_guard<std::mutex> lock(node_stats_mutex_);
+    node_stats_[key] = *stats;
+    return stats;
+}
+
+void WriterInternal::WriteNodeStats()
+{
+    // Nodes added while stats were disabled just have no entry
+    if (node_stats_.empty())
+        return;
+
+    auto data = NodeStats::PackNodes(node_stats_);
+    lazperf::evlr_header h{0, NodeStats::VLR_USER_ID, NodeStats::VLR_RECORD_ID, data.size(),
+                           "COPC node statistics"};
+
+    out_stream_.seekp(0, std::ios::end);
+    h.write(out_stream_);
+    out_stream_.write(data.data(), data.size());
+    evlr_count_++;
+}
+
 void WriterInternal::WritePage(const std::shared_ptr<PageInternal> &page)
 {
     auto page_size = page->nodes.size() * 32;
@@ -69,11 +69,22 @@ void Writer::Close()
         writer_->Close();
 }
 
+Writer::~Writer()
+{
+    try
+    {
+        Close();
+    }
+    catch (...)
+    {
+    }
+}
+
 bool Writer::PageExists(const VoxelKey &key) { return hierarchy_->PageExists(key); }
 
-// Writes a node to the file and reference it in the hierarchy and in the parent page
-Node Writer::DoAddNode(const VoxelKey &key, const std::vector<char> &in, int32_t point_count, bool compressed_data,
-                       const VoxelKey &page_key)
+namespace
+{
+void CheckNodeKeys(const VoxelKey &key, const VoxelKey &page_key)
 {
     if (!page_key.IsValid() || !key.IsValid())
         throw std::runtime_error("Invalid page or node key!");
@@ -81,36 +92,119 @@ Node Writer::DoAddNode(const VoxelKey &key, const std::vector<char> &in, int32_t
 
     if (!key.ChildOf(page_key))
         throw std::runtime_error("Target key " + key.ToString() + " is not a child of page node " + key.ToString());
+}
 
-    Entry e = writer_->WriteNode(in, point_count, compressed_data);
-    e.key = key;
+// Checks that `points` (las::Points or las::PointBuffer) can be written with `header`
+template <typename T>
+void CheckPoints(const T &points, const las::LasHeader &header, const std::string &function_name,
+                 const std::string &type_name)
+{
+    if (points.Size() == 0)
+        throw std::runtime_error(function_name + ": Cannot add empty " + type_name + ".");
+    if (points.PointFormatId() != header.PointFormatId() || points.PointRecordLength() != header.PointRecordLength())
+        throw std::runtime_error(function_name + ": New points must be of same format and size.");
+}
+} // namespace
 
-    auto node = std::make_shared<Node>(e, page_key);
-    hierarchy_->loaded_nodes_[key] = node;
+// Adds a node to the hierarchy and to its page, and returns a copy of it
+Node Writer::InsertNode(const std::shared_ptr<Node> &node)
+{
+    std::lock_guard<std::recursive_mutex> lock(hierarchy_->mutex_);
+    hierarchy_->loaded_nodes_[node->key] = node;
     // If page doesn't exist then create it
-    if (!PageExists(page_key))
+    if (!PageExists(node->page_key))
     {
-        auto new_page = std::make_shared<Internal::PageInternal>(page_key);
+        auto new_page = std::make_shared<Internal::PageInternal>(node->page_key);
         new_page->loaded = true;
-        hierarchy_->seen_pages_[page_key] = new_page;
+        hierarchy_->seen_pages_[node->page_key] = new_page;
     }
     // Add node to page
-    hierarchy_->seen_pages_[page_key]->nodes[node->key] = node;
+    hierarchy_->seen_pages_[node->page_key]->nodes[node->key] = node;
     return *node;
 }
 
+// Writes a node to the file and reference it in the hierarchy and in the parent page
+Node Writer::DoAddNode(const VoxelKey &key, const std::vector<char> &in, int32_t point_count, bool compressed_data,
+                       const VoxelKey &page_key)
+{
+    CheckNodeKeys(key, page_key);
+
+    if (writer_->Pipelined())
+    {
+        if (parallel_compression_)
+            return QueueNode(key, in, point_count, compressed_data, page_key);
+        // The pipeline was started by AddNodeAsync, so the node is written in order after the queued ones
+        writer_->Flush();
+    }
+
+    Entry e = writer_->WriteNode(in, point_count, compressed_data);
+    e.key = key;
+    auto node = std::make_shared<Node>(e, page_key);
+    if (writer_->AnalyzesNodes())
+        node->stats = writer_->AnalyzeNode(key, in, compressed_data, e.point_count);
+    return InsertNode(node);
+}
+
+// Adds a node to the hierarchy and queues it on the compression pipeline
+// The offset and byte size are set by the writer thread, once the node is in the file
+Node Writer::QueueNode(const VoxelKey &key, std::vector<char> in, int32_t point_count, bool compressed_data,
+                       const VoxelKey &page_key, std::promise<Node> written)
+{
+    Entry e;
+    e.key = key;
+    e.point_count =
+        compressed_data ? point_count : static_cast<int32_t>(in.size() / config_->LasHeader()->PointRecordLength());
+    auto node = std::make_shared<Node>(e, page_key);
+    Node added = InsertNode(node);
+
+    // Queued outside of the hierarchy lock, which the writer thread needs to record the node's offset
+    writer_->QueueNode(node, std::move(in), compressed_data, std::move(written));
+    return added;
+}
+
+std::future<Node> Writer::DoAddNodeAsync(const VoxelKey &key, std::vector<char> uncompressed_data,
+                                         const VoxelKey &page_key)
+{
+    CheckNodeKeys(key, page_key);
+
+    if (!writer_->Pipelined())
+        writer_->StartPipeline(0, DEFAULT_MAX_BYTES_IN_FLIGHT);
+
+    std::promise<Node> written;
+    auto future = written.get_future();
+    QueueNode(key, std::move(uncompressed_data), 0, false, page_key, std::move(written));
+    return future;
+}
+
 Node Writer::AddNode(const VoxelKey &key, const las::Points &points, const VoxelKey &page_key)
 {
-    if (points.Size() == 0)
-        throw std::runtime_error("Writer::AddNode: Cannot add empty las::Points.");
-    if (points.PointFormatId() != config_->LasHeader()->PointFormatId() ||
-        points.PointRecordLength() != config_->LasHeader()->PointRecordLength())
-        throw std::runtime_error("Writer::AddNode: New points must be of same format and size.");
+    CheckPoints(points, *config_->LasHeader(), "Writer::AddNode", "las::Points");
+
+    std::vector<char> uncompressed_data = points.Pack(*config_->LasHeader());
+    return AddNode(key, uncompressed_data, page_key);
+}
+
+Node Writer::AddNode(const VoxelKey &key, const las::PointBuffer &points, const VoxelKey &page_key)
+{
+    CheckPoints(points, *config_->LasHeader(), "Writer::AddNode", "las::PointBuffer");
 
     std::vector<char> uncompressed_data = points.Pack(*config_->LasHeader());
     return AddNode(key, uncompressed_data, page_key);
 }
 
+std::future<Node> Writer::AddNodeAsync(const VoxelKey &key, const las::Points &points, const VoxelKey &page_key)
+{
+    CheckPoints(points, *config_->LasHeader(), "Writer::AddNodeAsync", "las::Points");
+    return DoAddNodeAsync(key, points.Pack(*config_->LasHeader()), page_key);
+}
+
+std::future<Node> Writer::AddNodeAsync(const VoxelKey &key, const las::PointBuffer &points,
+                                       const VoxelKey &page_key)
+{
+    CheckPoints(points, *config_->LasHeader(), "Writer::AddNodeAsync", "las::PointBuffer");
+    return DoAddNodeAsync(key, points.Pack(*config_->LasHeader()), page_key);
+}
+
 Node Writer::AddNode(const VoxelKey &key, std::vector<char> const &uncompressed_data, const VoxelKey &page_key)
 {
     int point_size = config_->LasHeader()->PointRecordLength();
@@ -170,11 +264,49 @@ void Writer::ChangeNodePage(const VoxelKey &node_key, const VoxelKey &new_page_k
         hierarchy_->seen_pages_.erase(node->page_key);
 }
 
+void Writer::EnableParallelCompression(unsigned int num_threads, size_t max_bytes_in_flight)
+{
+    writer_->StartPipeline(num_threads, max_bytes_in_flight);
+    parallel_compression_ = true;
+}
+
+void Writer::EnableNodeStats(bool enable) { writer_->EnableNodeStats(enable); }
+
+void Writer::EnableAutoExtents(bool enable) { writer_->EnableAutoExtents(enable); }
+
+ExtentsAccumulator Writer::AccumulatedExtents() { return writer_->AccumulatedExtents(); }
+
+void Writer::Flush()
+{
+    if (writer_->Pipelined())
+        writer_->Flush();
+}
+
 void FileWriter::Close()
 {
-    if (writer_ != nullptr)
-        writer_->Close();
+    // The file is closed even if the writer failed
+    try
+    {
+        if (writer_ != nullptr)
+            writer_->Close();
+    }
+    catch (...)
+    {
+        laz::BaseFileWriter::Close();
+        throw;
+    }
     laz::BaseFileWriter::Close();
 }
 
+FileWriter::~FileWriter()
+{
+    try
+    {
+        Close();
+    }
+    catch (...)
+    {
+    }
+}
+
 } // namespace copc
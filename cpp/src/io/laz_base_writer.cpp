@@ -141,6 +141,21 @@ int32_t BaseWriter::WriteChunk(const std::vector<char> &in, int32_t point_count,
     return point_count;
 }
 
+void BaseWriter::AccumulateExtents(const las::PointBuffer &points)
+{
+    ExtentsAccumulator batch;
+    batch.Add(points);
+
+    std::lock_guard<std::mutex> lock(extents_mutex_);
+    extents_.Merge(batch);
+}
+
+ExtentsAccumulator BaseWriter::AccumulatedExtents()
+{
+    std::lock_guard<std::mutex> lock(extents_mutex_);
+    return extents_;
+}
+
 void BaseWriter::Close()
 {
     if (!open_)
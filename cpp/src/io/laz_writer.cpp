@@ -2,6 +2,8 @@
 
 #include <memory>
 
+#include "copc-lib/laz/decompressor.hpp"
+
 namespace copc::laz
 {
 
@@ -22,6 +24,9 @@ void LazWriter::WritePoints(const las::Points &points)
         points.PointRecordLength() != config_->LasHeader().PointRecordLength())
         throw std::runtime_error("LazWriter::WritePoints: New points must be of same format and size.");
 
+    if (auto_extents_)
+        AccumulateExtents(las::PointBuffer(points));
+
     std::vector<char> uncompressed_data = points.Pack(config_->LasHeader());
     WriteChunk(uncompressed_data);
 }
@@ -32,7 +37,21 @@ void LazWriter::WritePointsCompressed(std::vector<char> const &compressed_data,
     if (point_count == 0)
         throw std::runtime_error("Point count must be >0!");
 
+    if (auto_extents_)
+    {
+        auto header = config_->LasHeader();
+        AccumulateExtents(las::PointBuffer::Unpack(
+            laz::Decompressor::DecompressBytes(compressed_data, header, point_count), header));
+    }
+
     WriteChunk(compressed_data, point_count, true);
 }
 
+void LazWriter::Close()
+{
+    if (open_ && auto_extents_)
+        AccumulatedExtents().ApplyBounds(*LazConfig()->LasHeader());
+    BaseWriter::Close();
+}
+
 } // namespace copc::laz
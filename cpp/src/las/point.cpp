@@ -1,6 +1,8 @@
 #include "copc-lib/las/point.hpp"
 #include "copc-lib/utils.hpp"
 
+#include <cstring>
+
 namespace copc::las
 {
 Point::Point(const int8_t &point_format_id, const uint16_t &eb_byte_size) : point_format_id_(point_format_id)
@@ -111,6 +113,63 @@ std::shared_ptr<Point> Point::Unpack(std::istream &in_stream, const int8_t &poin
     return p;
 }
 
+std::shared_ptr<Point> Point::Unpack(const char *in, const int8_t &point_format_id, const Vector3 &scale,
+                                     const Vector3 &offset, const uint16_t &eb_byte_size)
+{
+    std::shared_ptr<Point> p = std::make_shared<Point>(point_format_id, eb_byte_size);
+
+    // Offsets of the PDRF 6-8 record
+    p->x_scaled_ = ApplyScale(unpack<int32_t>(in), scale.x, offset.x);
+    p->y_scaled_ = ApplyScale(unpack<int32_t>(in + 4), scale.y, offset.y);
+    p->z_scaled_ = ApplyScale(unpack<int32_t>(in + 8), scale.z, offset.z);
+    p->intensity_ = unpack<uint16_t>(in + 12);
+    p->returns_ = unpack<uint8_t>(in + 14);
+    p->flags_ = unpack<uint8_t>(in + 15);
+    p->classification_ = unpack<uint8_t>(in + 16);
+    p->user_data_ = unpack<uint8_t>(in + 17);
+    p->scan_angle_ = unpack<int16_t>(in + 18);
+    p->point_source_id_ = unpack<uint16_t>(in + 20);
+    p->gps_time_ = unpack<double>(in + 22);
+    if (p->has_rgb_)
+    {
+        p->rgb_[0] = unpack<uint16_t>(in + 30);
+        p->rgb_[1] = unpack<uint16_t>(in + 32);
+        p->rgb_[2] = unpack<uint16_t>(in + 34);
+    }
+    if (p->has_nir_)
+        p->nir_ = unpack<uint16_t>(in + 36);
+
+    if (eb_byte_size > 0)
+        std::memcpy(p->extra_bytes_.data(), in + PointBaseByteSize(point_format_id), eb_byte_size);
+    return p;
+}
+
+void Point::Pack(char *out, const Vector3 &scale, const Vector3 &offset) const
+{
+    pack(RemoveScale<int32_t>(x_scaled_, scale.x, offset.x), out);
+    pack(RemoveScale<int32_t>(y_scaled_, scale.y, offset.y), out + 4);
+    pack(RemoveScale<int32_t>(z_scaled_, scale.z, offset.z), out + 8);
+    pack(intensity_, out + 12);
+    pack(returns_, out + 14);
+    pack(flags_, out + 15);
+    pack(classification_, out + 16);
+    pack(user_data_, out + 17);
+    pack(scan_angle_, out + 18);
+    pack(point_source_id_, out + 20);
+    pack(gps_time_, out + 22);
+    if (has_rgb_)
+    {
+        pack(rgb_[0], out + 30);
+        pack(rgb_[1], out + 32);
+        pack(rgb_[2], out + 34);
+    }
+    if (has_nir_)
+        pack(nir_, out + 36);
+
+    if (!extra_bytes_.empty())
+        std::memcpy(out + PointBaseByteSize(point_format_id_), extra_bytes_.data(), extra_bytes_.size());
+}
+
 void Point::Pack(std::ostream &out_stream, const Vector3 &scale, const Vector3 &offset) const
 {
     // Point
@@ -0,0 +1,473 @@
+#include "copc-lib/las/point_buffer.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+
+#include "copc-lib/las/utils.hpp"
+
+namespace copc::las
+{
+
+namespace
+{
+// Reads the field at `field_offset` of every point record into `out`
+template <typename T>
+void UnpackColumn(const char *point_data, const size_t &point_count, const size_t &point_record_length,
+                  const size_t &field_offset, std::vector<T> &out)
+{
+    const char *src = point_data + field_offset;
+    for (size_t i = 0; i < point_count; i++, src += point_record_length)
+        out[i] = unpack<T>(src);
+}
+
+template <typename T>
+void UnpackScaledColumn(const char *point_data, const size_t &point_count, const size_t &point_record_length,
+                        const size_t &field_offset, const double &scale, const double &offset,
+                        std::vector<double> &out)
+{
+    const char *src = point_data + field_offset;
+    for (size_t i = 0; i < point_count; i++, src += point_record_length)
+        out[i] = ApplyScale(unpack<T>(src), scale, offset);
+}
+} // namespace
+
+PointBuffer::PointBuffer(const int8_t &point_format_id, const uint16_t &eb_byte_size, const uint32_t &dimensions)
+    : point_format_id_(point_format_id), eb_byte_size_(eb_byte_size), dimensions_(dimensions & Dimension::DIM_ALL)
+{
+    if (point_format_id < 6 || point_format_id > 8)
+        throw std::runtime_error("PointBuffer: Point format must be 6-8.");
+
+    point_record_length_ = PointByteSize(point_format_id, eb_byte_size);
+    has_rgb_ = FormatHasRgb(point_format_id);
+    has_nir_ = FormatHasNir(point_format_id);
+
+    // Drop the dimensions this point format doesn't have
+    if (!has_rgb_)
+        dimensions_ &= ~Dimension::DIM_RGB;
+    if (!has_nir_)
+        dimensions_ &= ~Dimension::DIM_NIR;
+    if (eb_byte_size_ == 0)
+        dimensions_ &= ~Dimension::DIM_EXTRA_BYTES;
+}
+
+PointBuffer::PointBuffer(const LasHeader &header, const uint32_t &dimensions)
+    : PointBuffer(header.PointFormatId(), header.EbByteSize(), dimensions)
+{
+}
+
+PointBuffer::PointBuffer(const Points &points) : PointBuffer(points.PointFormatId(), points.EbByteSize())
+{
+    Reserve(points.Size());
+    for (const auto &point : points)
+        AddPoint(*point);
+}
+
+bool PointBuffer::HasAllDimensions() const
+{
+    uint32_t all_dimensions = Dimension::DIM_ALL;
+    if (!has_rgb_)
+        all_dimensions &= ~Dimension::DIM_RGB;
+    if (!has_nir_)
+        all_dimensions &= ~Dimension::DIM_NIR;
+    if (eb_byte_size_ == 0)
+        all_dimensions &= ~Dimension::DIM_EXTRA_BYTES;
+    return dimensions_ == all_dimensions;
+}
+
+void PointBuffer::Reserve(const size_t &num)
+{
+    if (HasDimension(DIM_XYZ))
+    {
+        x_.reserve(num);
+        y_.reserve(num);
+        z_.reserve(num);
+    }
+    if (HasDimension(DIM_INTENSITY))
+        intensity_.reserve(num);
+    if (HasDimension(DIM_RETURNS))
+        returns_.reserve(num);
+    if (HasDimension(DIM_FLAGS))
+        flags_.reserve(num);
+    if (HasDimension(DIM_CLASSIFICATION))
+        classification_.reserve(num);
+    if (HasDimension(DIM_USER_DATA))
+        user_data_.reserve(num);
+    if (HasDimension(DIM_SCAN_ANGLE))
+        scan_angle_.reserve(num);
+    if (HasDimension(DIM_POINT_SOURCE_ID))
+        point_source_id_.reserve(num);
+    if (HasDimension(DIM_GPS_TIME))
+        gps_time_.reserve(num);
+    if (HasDimension(DIM_RGB))
+    {
+        red_.reserve(num);
+        green_.reserve(num);
+        blue_.reserve(num);
+    }
+    if (HasDimension(DIM_NIR))
+        nir_.reserve(num);
+    if (HasDimension(DIM_EXTRA_BYTES))
+        extra_bytes_.reserve(num * eb_byte_size_);
+}
+
+void PointBuffer::Resize(const size_t &num)
+{
+    if (HasDimension(DIM_XYZ))
+    {
+        x_.resize(num);
+        y_.resize(num);
+        z_.resize(num);
+    }
+    if (HasDimension(DIM_INTENSITY))
+        intensity_.resize(num);
+    if (HasDimension(DIM_RETURNS))
+        returns_.resize(num);
+    if (HasDimension(DIM_FLAGS))
+        flags_.resize(num);
+    if (HasDimension(DIM_CLASSIFICATION))
+        classification_.resize(num);
+    if (HasDimension(DIM_USER_DATA))
+        user_data_.resize(num);
+    if (HasDimension(DIM_SCAN_ANGLE))
+        scan_angle_.resize(num);
+    if (HasDimension(DIM_POINT_SOURCE_ID))
+        point_source_id_.resize(num);
+    if (HasDimension(DIM_GPS_TIME))
+        gps_time_.resize(num);
+    if (HasDimension(DIM_RGB))
+    {
+        red_.resize(num);
+        green_.resize(num);
+        blue_.resize(num);
+    }
+    if (HasDimension(DIM_NIR))
+        nir_.resize(num);
+    if (HasDimension(DIM_EXTRA_BYTES))
+        extra_bytes_.resize(num * eb_byte_size_);
+    size_ = num;
+}
+
+void PointBuffer::AddPoint(const Point &point)
+{
+    if (point.PointFormatId() != point_format_id_ || point.PointRecordLength() != point_record_length_)
+        throw std::runtime_error("PointBuffer::AddPoint: New point must be of same format and byte_size.");
+
+    if (HasDimension(DIM_XYZ))
+    {
+        x_.push_back(point.X());
+        y_.push_back(point.Y());
+        z_.push_back(point.Z());
+    }
+    if (HasDimension(DIM_INTENSITY))
+        intensity_.push_back(point.Intensity());
+    if (HasDimension(DIM_RETURNS))
+        returns_.push_back(point.ReturnsBitField());
+    if (HasDimension(DIM_FLAGS))
+        flags_.push_back(point.FlagsBitField());
+    if (HasDimension(DIM_CLASSIFICATION))
+        classification_.push_back(point.Classification());
+    if (HasDimension(DIM_USER_DATA))
+        user_data_.push_back(point.UserData());
+    if (HasDimension(DIM_SCAN_ANGLE))
+        scan_angle_.push_back(point.ScanAngle());
+    if (HasDimension(DIM_POINT_SOURCE_ID))
+        point_source_id_.push_back(point.PointSourceId());
+    if (HasDimension(DIM_GPS_TIME))
+        gps_time_.push_back(point.GPSTime());
+    if (HasDimension(DIM_RGB))
+    {
+        red_.push_back(point.Red());
+        green_.push_back(point.Green());
+        blue_.push_back(point.Blue());
+    }
+    if (HasDimension(DIM_NIR))
+        nir_.push_back(point.Nir());
+    if (HasDimension(DIM_EXTRA_BYTES))
+    {
+        auto extra_bytes = point.ExtraBytes();
+        extra_bytes_.insert(extra_bytes_.end(), extra_bytes.begin(), extra_bytes.end());
+    }
+    size_++;
+}
+
+void PointBuffer::AddPoints(const PointBuffer &points)
+{
+    if (points.PointFormatId() != point_format_id_ || points.PointRecordLength() != point_record_length_)
+        throw std::runtime_error("PointBuffer::AddPoints: New points must be of same format and byte_size.");
+    if (points.Dimensions() != dimensions_)
+        throw std::runtime_error("PointBuffer::AddPoints: New points must hold the same dimensions.");
+
+    // Columns that aren't held are empty on both sides
+    auto append = [](auto &dst, const auto &src) { dst.insert(dst.end(), src.begin(), src.end()); };
+    append(x_, points.x_);
+    append(y_, points.y_);
+    append(z_, points.z_);
+    append(intensity_, points.intensity_);
+    append(returns_, points.returns_);
+    append(flags_, points.flags_);
+    append(classification_, points.classification_);
+    append(user_data_, points.user_data_);
+    append(scan_angle_, points.scan_angle_);
+    append(point_source_id_, points.point_source_id_);
+    append(gps_time_, points.gps_time_);
+    append(red_, points.red_);
+    append(green_, points.green_);
+    append(blue_, points.blue_);
+    append(nir_, points.nir_);
+    append(extra_bytes_, points.extra_bytes_);
+    size_ += points.Size();
+}
+
+void PointBuffer::PushBack(const PointBuffer &other, const size_t &idx)
+{
+    if (HasDimension(DIM_XYZ))
+    {
+        x_.push_back(other.x_[idx]);
+        y_.push_back(other.y_[idx]);
+        z_.push_back(other.z_[idx]);
+    }
+    if (HasDimension(DIM_INTENSITY))
+        intensity_.push_back(other.intensity_[idx]);
+    if (HasDimension(DIM_RETURNS))
+        returns_.push_back(other.returns_[idx]);
+    if (HasDimension(DIM_FLAGS))
+        flags_.push_back(other.flags_[idx]);
+    if (HasDimension(DIM_CLASSIFICATION))
+        classification_.push_back(other.classification_[idx]);
+    if (HasDimension(DIM_USER_DATA))
+        user_data_.push_back(other.user_data_[idx]);
+    if (HasDimension(DIM_SCAN_ANGLE))
+        scan_angle_.push_back(other.scan_angle_[idx]);
+    if (HasDimension(DIM_POINT_SOURCE_ID))
+        point_source_id_.push_back(other.point_source_id_[idx]);
+    if (HasDimension(DIM_GPS_TIME))
+        gps_time_.push_back(other.gps_time_[idx]);
+    if (HasDimension(DIM_RGB))
+    {
+        red_.push_back(other.red_[idx]);
+        green_.push_back(other.green_[idx]);
+        blue_.push_back(other.blue_[idx]);
+    }
+    if (HasDimension(DIM_NIR))
+        nir_.push_back(other.nir_[idx]);
+    if (HasDimension(DIM_EXTRA_BYTES))
+    {
+        auto eb_begin = other.extra_bytes_.begin() + idx * eb_byte_size_;
+        extra_bytes_.insert(extra_bytes_.end(), eb_begin, eb_begin + eb_byte_size_);
+    }
+    size_++;
+}
+
+std::shared_ptr<Point> PointBuffer::GetPoint(const size_t &idx) const
+{
+    if (idx >= Size())
+        throw std::out_of_range("PointBuffer::GetPoint: Index " + std::to_string(idx) + " is out of range.");
+
+    // Dimensions that aren't held are left at their default values
+    auto point = std::make_shared<Point>(point_format_id_, eb_byte_size_);
+    if (HasDimension(DIM_XYZ))
+    {
+        point->X(x_[idx]);
+        point->Y(y_[idx]);
+        point->Z(z_[idx]);
+    }
+    if (HasDimension(DIM_INTENSITY))
+        point->Intensity(intensity_[idx]);
+    if (HasDimension(DIM_RETURNS))
+        point->ReturnsBitField(returns_[idx]);
+    if (HasDimension(DIM_FLAGS))
+        point->FlagsBitField(flags_[idx]);
+    if (HasDimension(DIM_CLASSIFICATION))
+        point->Classification(classification_[idx]);
+    if (HasDimension(DIM_USER_DATA))
+        point->UserData(user_data_[idx]);
+    if (HasDimension(DIM_SCAN_ANGLE))
+        point->ScanAngle(scan_angle_[idx]);
+    if (HasDimension(DIM_POINT_SOURCE_ID))
+        point->PointSourceId(point_source_id_[idx]);
+    if (HasDimension(DIM_GPS_TIME))
+        point->GPSTime(gps_time_[idx]);
+    if (HasDimension(DIM_RGB))
+        point->Rgb(red_[idx], green_[idx], blue_[idx]);
+    if (HasDimension(DIM_NIR))
+        point->Nir(nir_[idx]);
+    if (HasDimension(DIM_EXTRA_BYTES))
+    {
+        auto eb_begin = extra_bytes_.begin() + idx * eb_byte_size_;
+        point->ExtraBytes(std::vector<uint8_t>(eb_begin, eb_begin + eb_byte_size_));
+    }
+    return point;
+}
+
+Points PointBuffer::ToPoints() const
+{
+    Points points(point_format_id_, eb_byte_size_);
+    points.Reserve(Size());
+    for (size_t i = 0; i < Size(); i++)
+        points.AddPoint(GetPoint(i));
+    return points;
+}
+
+PointBuffer PointBuffer::Unpack(const std::vector<char> &point_data, const LasHeader &header,
+                                const uint32_t &dimensions)
+{
+    return Unpack(point_data, header.PointFormatId(), header.EbByteSize(), header.Scale(), header.Offset(),
+                  dimensions);
+}
+
+PointBuffer PointBuffer::Unpack(const std::vector<char> &point_data, const int8_t &point_format_id,
+                                const uint16_t &eb_byte_size, const Vector3 &scale, const Vector3 &offset,
+                                const uint32_t &dimensions)
+{
+    return Unpack(point_data.data(), point_data.size(), point_format_id, eb_byte_size, scale, offset, dimensions);
+}
+
+PointBuffer PointBuffer::Unpack(const char *point_data, size_t size, const int8_t &point_format_id,
+                                const uint16_t &eb_byte_size, const Vector3 &scale, const Vector3 &offset,
+                                const uint32_t &dimensions)
+{
+    PointBuffer points(point_format_id, eb_byte_size, dimensions);
+    size_t point_record_length = points.PointRecordLength();
+    if (size % point_record_length != 0)
+        throw std::runtime_error("PointBuffer::Unpack: Invalid input point array!");
+
+    size_t point_count = size / point_record_length;
+    points.Resize(point_count);
+
+    // PDRF 6-8 share the same 30 byte base record, followed by RGB (7, 8), NIR (8) and the extra bytes.
+    // Each requested column is read in its own pass, so unrequested fields are never touched.
+    if (points.HasDimension(DIM_XYZ))
+    {
+        UnpackScaledColumn<int32_t>(point_data, point_count, point_record_length, 0, scale.x, offset.x, points.x_);
+        UnpackScaledColumn<int32_t>(point_data, point_count, point_record_length, 4, scale.y, offset.y, points.y_);
+        UnpackScaledColumn<int32_t>(point_data, point_count, point_record_length, 8, scale.z, offset.z, points.z_);
+    }
+    if (points.HasDimension(DIM_INTENSITY))
+        UnpackColumn(point_data, point_count, point_record_length, 12, points.intensity_);
+    if (points.HasDimension(DIM_RETURNS))
+        UnpackColumn(point_data, point_count, point_record_length, 14, points.returns_);
+    if (points.HasDimension(DIM_FLAGS))
+        UnpackColumn(point_data, point_count, point_record_length, 15, points.flags_);
+    if (points.HasDimension(DIM_CLASSIFICATION))
+        UnpackColumn(point_data, point_count, point_record_length, 16, points.classification_);
+    if (points.HasDimension(DIM_USER_DATA))
+        UnpackColumn(point_data, point_count, point_record_length, 17, points.user_data_);
+    if (points.HasDimension(DIM_SCAN_ANGLE))
+        UnpackColumn(point_data, point_count, point_record_length, 18, points.scan_angle_);
+    if (points.HasDimension(DIM_POINT_SOURCE_ID))
+        UnpackColumn(point_data, point_count, point_record_length, 20, points.point_source_id_);
+    if (points.HasDimension(DIM_GPS_TIME))
+        UnpackColumn(point_data, point_count, point_record_length, 22, points.gps_time_);
+    if (points.HasDimension(DIM_RGB))
+    {
+        UnpackColumn(point_data, point_count, point_record_length, 30, points.red_);
+        UnpackColumn(point_data, point_count, point_record_length, 32, points.green_);
+        UnpackColumn(point_data, point_count, point_record_length, 34, points.blue_);
+    }
+    if (points.HasDimension(DIM_NIR))
+        UnpackColumn(point_data, point_count, point_record_length, 36, points.nir_);
+    if (points.HasDimension(DIM_EXTRA_BYTES))
+    {
+        const size_t eb_offset = PointBaseByteSize(point_format_id);
+        for (size_t i = 0; i < point_count; i++)
+            std::memcpy(points.extra_bytes_.data() + i * eb_byte_size, point_data + i * point_record_length + eb_offset,
+                        eb_byte_size);
+    }
+    return points;
+}
+
+std::vector<char> PointBuffer::Pack(const LasHeader &header) const { return Pack(header.Scale(), header.Offset()); }
+
+std::vector<char> PointBuffer::Pack(const Vector3 &scale, const Vector3 &offset) const
+{
+    if (!HasAllDimensions())
+        throw std::runtime_error("PointBuffer::Pack: Cannot pack a PointBuffer that doesn't hold all dimensions.");
+
+    std::vector<char> out(Size() * point_record_length_);
+    for (size_t i = 0; i < Size(); i++)
+        PackPoint(i, out.data() + i * point_record_length_, scale, offset);
+    return out;
+}
+
+void PointBuffer::PackPoint(const size_t &idx, char *out, const Vector3 &scale, const Vector3 &offset) const
+{
+    if (!HasAllDimensions())
+        throw std::runtime_error("PointBuffer::PackPoint: Cannot pack a PointBuffer that doesn't hold all dimensions.");
+
+    pack(RemoveScale<int32_t>(x_[idx], scale.x, offset.x), out);
+    pack(RemoveScale<int32_t>(y_[idx], scale.y, offset.y), out + 4);
+    pack(RemoveScale<int32_t>(z_[idx], scale.z, offset.z), out + 8);
+    pack(intensity_[idx], out + 12);
+    pack(returns_[idx], out + 14);
+    pack(flags_[idx], out + 15);
+    pack(classification_[idx], out + 16);
+    pack(user_data_[idx], out + 17);
+    pack(scan_angle_[idx], out + 18);
+    pack(point_source_id_[idx], out + 20);
+    pack(gps_time_[idx], out + 22);
+    if (has_rgb_)
+    {
+        pack(red_[idx], out + 30);
+        pack(green_[idx], out + 32);
+        pack(blue_[idx], out + 34);
+    }
+    if (has_nir_)
+        pack(nir_[idx], out + 36);
+    if (eb_byte_size_ > 0)
+        std::memcpy(out + PointBaseByteSize(point_format_id_), extra_bytes_.data() + idx * eb_byte_size_,
+                    eb_byte_size_);
+}
+
+bool PointBuffer::Within(const Box &box) const
+{
+    if (!HasDimension(DIM_XYZ))
+        throw std::runtime_error("PointBuffer::Within: The XYZ dimension is required.");
+
+    for (size_t i = 0; i < Size(); i++)
+    {
+        if (!box.Contains(Vector3(x_[i], y_[i], z_[i])))
+            return false;
+    }
+    return true;
+}
+
+PointBuffer PointBuffer::GetWithin(const Box &box) const
+{
+    if (!HasDimension(DIM_XYZ))
+        throw std::runtime_error("PointBuffer::GetWithin: The XYZ dimension is required.");
+
+    PointBuffer out(point_format_id_, eb_byte_size_, dimensions_);
+    for (size_t i = 0; i < Size(); i++)
+    {
+        if (box.Contains(Vector3(x_[i], y_[i], z_[i])))
+            out.PushBack(*this, i);
+    }
+    return out;
+}
+
+PointBuffer PointBuffer::GetSubset(const std::vector<uint8_t> &mask) const
+{
+    if (mask.size() != Size())
+        throw std::runtime_error("PointBuffer::GetSubset: The mask must have one entry per point.");
+
+    PointBuffer out(point_format_id_, eb_byte_size_, dimensions_);
+    out.Reserve(static_cast<size_t>(std::count_if(mask.begin(), mask.end(), [](uint8_t keep) { return keep != 0; })));
+    for (size_t i = 0; i < Size(); i++)
+    {
+        if (mask[i])
+            out.PushBack(*this, i);
+    }
+    return out;
+}
+
+std::string PointBuffer::ToString() const
+{
+    std::stringstream ss;
+    ss << "# of points: " << Size() << ", Point Format: " << static_cast<int>(point_format_id_)
+       << ", # Extra Bytes: " << eb_byte_size_ << ", Point Record Length: " << point_record_length_;
+    return ss.str();
+}
+
+} // namespace copc::las
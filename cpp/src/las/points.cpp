@@ -81,17 +81,16 @@ Points Points::Unpack(const std::vector<char> &point_data, const int8_t &point_f
 
     uint64_t point_count = point_data.size() / point_record_length;
 
-    // Make a stream out of the vector of char
-    auto ss = std::istringstream(std::string(point_data.begin(), point_data.end()));
-
-    // Go through each Point to unpack the data from the stream
+    // Go through each Point to unpack the data straight from the buffer
     Points points(point_format_id, eb_byte_size);
     points.Reserve(point_count);
 
     // Unpack points
-    for (int i = 0; i < point_count; i++)
+    const char *in = point_data.data();
+    for (uint64_t i = 0; i < point_count; i++)
     {
-        points.AddPoint(las::Point::Unpack(ss, point_format_id, scale, offset, eb_byte_size));
+        points.points_.push_back(las::Point::Unpack(in + i * point_record_length, point_format_id, scale, offset,
+                                                    eb_byte_size));
     }
 
     return points;
@@ -112,10 +111,10 @@ std::vector<char> Points::Pack(const LasHeader &header) const { return Pack(head
 
 std::vector<char> Points::Pack(const Vector3 &scale, const Vector3 &offset) const
 {
-    std::stringstream out;
-    Pack(out, scale, offset);
-    auto ostr = out.str();
-    return std::vector<char>(ostr.begin(), ostr.end());
+    std::vector<char> out(points_.size() * point_record_length_);
+    for (size_t i = 0; i < points_.size(); i++)
+        points_[i]->Pack(out.data() + i * point_record_length_, scale, offset);
+    return out;
 }
 
 std::string Points::ToString() const
@@ -0,0 +1,53 @@
+#include "copc-lib/laz/compressor.hpp"
+
+#include "copc-lib/io/internal/thread_pool.hpp"
+
+namespace copc::laz
+{
+
+namespace
+{
+// Pool shared by the batch CompressPoints calls, so that each call doesn't start and join its own threads
+// It only grows, to the largest thread count a call has asked for. It's never destroyed, since joining its workers
+// while statics are destroyed can deadlock (e.g. when the library is unloaded on Windows)
+Internal::ThreadPool &SharedPool(size_t num_threads)
+{
+    static auto *pool = new Internal::ThreadPool(Internal::ThreadPool::DefaultThreadCount());
+    pool->Grow(num_threads);
+    return *pool;
+}
+} // namespace
+
+std::vector<std::vector<char>> Compressor::CompressPoints(const std::vector<las::Points> &points,
+                                                          const las::LasHeader &header, unsigned int num_threads,
+                                                          ExtentsAccumulator *extents)
+{
+    std::vector<std::vector<char>> out(points.size());
+    // Each chunk is accumulated on its own, and they're merged in order so the result doesn't depend on threads
+    std::vector<ExtentsAccumulator> chunk_extents(extents != nullptr ? points.size() : 0);
+    auto compress = [&](size_t i)
+    {
+        auto packed = points[i].Pack(header);
+        if (extents != nullptr)
+            chunk_extents[i].Add(las::PointBuffer::Unpack(packed, header));
+        out[i] = CompressBytes(packed, header.PointFormatId(), header.EbByteSize());
+    };
+
+    if (num_threads == 0)
+        num_threads = Internal::ThreadPool::DefaultThreadCount();
+    if (num_threads == 1 || points.size() <= 1)
+    {
+        for (size_t i = 0; i < points.size(); i++)
+            compress(i);
+    }
+    else
+    {
+        SharedPool(num_threads).ForEach(points.size(), num_threads, compress);
+    }
+
+    for (const auto &chunk : chunk_extents)
+        extents->Merge(chunk);
+    return out;
+}
+
+} // namespace copc::laz
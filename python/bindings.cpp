@@ -2,24 +2,33 @@
 #include <cstddef>
 #include <optional>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include <pybind11/numpy.h>
 #include <pybind11/operators.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 #include <pybind11/stl_bind.h>
 
 #include <copc-lib/copc/extents.hpp>
+#include <copc-lib/copc/extents_accumulator.hpp>
 #include <copc-lib/copc/info.hpp>
+#include <copc-lib/copc/node_stats.hpp>
+#include <copc-lib/copc/point_filter.hpp>
 #include <copc-lib/geometry/box.hpp>
 #include <copc-lib/hierarchy/key.hpp>
+#include <copc-lib/hierarchy/morton_key.hpp>
 #include <copc-lib/hierarchy/node.hpp>
+#include <copc-lib/io/copc_mmap_reader.hpp>
+#include <copc-lib/io/copc_pread_reader.hpp>
 #include <copc-lib/io/copc_reader.hpp>
 #include <copc-lib/io/copc_writer.hpp>
 #include <copc-lib/io/laz_reader.hpp>
 #include <copc-lib/io/laz_writer.hpp>
 #include <copc-lib/las/header.hpp>
+#include <copc-lib/las/point_buffer.hpp>
 #include <copc-lib/las/point.hpp>
 #include <copc-lib/las/points.hpp>
 #include <copc-lib/las/vlr.hpp>
@@ -31,6 +40,72 @@ using namespace copc;
 
 PYBIND11_MAKE_OPAQUE(std::vector<char>)
 
+// Number of live NumPy views of each PointBuffer's columns, only accessed while holding the GIL
+std::unordered_map<const las::PointBuffer *, size_t> &PointBufferViews()
+{
+    static std::unordered_map<const las::PointBuffer *, size_t> views;
+    return views;
+}
+
+// Throws if NumPy arrays still view the buffer's columns, since growing the buffer would move them
+void CheckNoPointBufferViews(const las::PointBuffer &buffer)
+{
+    auto views = PointBufferViews().find(&buffer);
+    if (views != PointBufferViews().end() && views->second > 0)
+        throw std::runtime_error("PointBuffer can't be resized while NumPy arrays view its columns!");
+}
+
+// Base object of the column arrays, that keeps the PointBuffer alive and counts as a view of it
+struct PointBufferView
+{
+    py::object owner;
+    const las::PointBuffer *buffer;
+};
+
+// Binds a PointBuffer column as a property, the setter must keep the column's size
+// Also binds `<name>_array`, a NumPy array that views the column's memory without copying it. The array keeps the
+// PointBuffer alive, and the buffer refuses to resize for as long as it exists.
+template <typename T>
+void DefPointBufferColumn(py::class_<las::PointBuffer> &cls, const char *name,
+                          std::vector<T> &(las::PointBuffer::*column)())
+{
+    cls.def_property(
+        name, [column](las::PointBuffer &s) { return (s.*column)(); },
+        [column, name](las::PointBuffer &s, const std::vector<T> &in)
+        {
+            auto &out = (s.*column)();
+            if (in.size() != out.size())
+                throw std::runtime_error(std::string(name) + " setter array must be same size as the column!");
+            out = in;
+        });
+    cls.def_property_readonly((std::string(name) + "_array").c_str(),
+                              [column](py::object self)
+                              {
+                                  auto &buffer = self.cast<las::PointBuffer &>();
+                                  auto &values = (buffer.*column)();
+                                  py::capsule base(new PointBufferView{self, &buffer},
+                                                   [](void *ptr)
+                                                   {
+                                                       auto *view = static_cast<PointBufferView *>(ptr);
+                                                       auto views = PointBufferViews().find(view->buffer);
+                                                       if (--views->second == 0)
+                                                           PointBufferViews().erase(views);
+                                                       delete view;
+                                                   });
+                                  PointBufferViews()[&buffer]++;
+                                  return py::array_t<T>(values.size(), values.data(), base);
+                              });
+}
+
+// Reader::GetNodeStats, that returns None if the file has no statistics for the node
+std::optional<NodeStats> GetNodeStats(Reader &reader, const VoxelKey &key)
+{
+    NodeStats stats;
+    if (!reader.GetNodeStats(key, stats))
+        return std::nullopt;
+    return stats;
+}
+
 PYBIND11_MODULE(_core, m)
 {
     py::bind_vector<std::vector<char>>(m, "VectorChar", py::buffer_protocol())
@@ -94,6 +169,33 @@ PYBIND11_MODULE(_core, m)
             }));
     py::implicitly_convertible<py::tuple, VoxelKey>();
 
+    py::class_<MortonKey>(m, "MortonKey")
+        .def(py::init<>())
+        .def(py::init<const VoxelKey &>(), py::arg("key"))
+        .def_static("FromCode", &MortonKey::FromCode, py::arg("code"))
+        .def_static("Representable", &MortonKey::Representable, py::arg("key"))
+        .def_static("RootKey", &MortonKey::RootKey)
+        .def_readonly_static("MAX_DEPTH", &MortonKey::MAX_DEPTH)
+        .def_property_readonly("code", &MortonKey::Code)
+        .def_property_readonly("depth", &MortonKey::Depth)
+        .def("IsValid", &MortonKey::IsValid)
+        .def("ToVoxelKey", &MortonKey::ToVoxelKey)
+        .def("Parent", &MortonKey::Parent)
+        .def("ParentAtDepth", &MortonKey::ParentAtDepth, py::arg("depth"))
+        .def("Direction", &MortonKey::Direction)
+        .def("Child", &MortonKey::Child, py::arg("direction"))
+        .def("Children", &MortonKey::Children)
+        .def("Siblings", &MortonKey::Siblings)
+        .def("ChildOf", &MortonKey::ChildOf, py::arg("ancestor"))
+        .def("PreorderPosition", &MortonKey::PreorderPosition)
+        .def("DescendantRange", &MortonKey::DescendantRange)
+        .def(py::self == py::self)
+        .def(py::self != py::self)
+        .def(py::self < py::self)
+        .def(py::hash(py::self))
+        .def("__str__", &MortonKey::ToString)
+        .def("__repr__", &MortonKey::ToString);
+
     py::class_<Box>(m, "Box")
         .def(py::init<>())
         .def(py::init<const double &, const double &, const double &, const double &, const double &, const double &>(),
@@ -127,6 +229,13 @@ PYBIND11_MODULE(_core, m)
         .def_readwrite("offset", &Node::offset)
         .def_readwrite("byte_size", &Node::byte_size)
         .def_readwrite("page_key", &Node::page_key)
+        .def_property_readonly("stats",
+                               [](const Node &n) -> std::optional<NodeStats>
+                               {
+                                   if (!n.stats)
+                                       return std::nullopt;
+                                   return *n.stats;
+                               })
         .def("IsValid", &Node::IsValid)
         .def("IsPage", &Node::IsPage)
         .def("__str__", &Node::ToString)
@@ -382,16 +491,199 @@ PYBIND11_MODULE(_core, m)
         .def("__str__", &las::Points::ToString)
         .def("__repr__", &las::Points::ToString);
 
-    py::class_<FileReader>(m, "FileReader")
-        .def(py::init<std::string &>())
-        .def("Close", &FileReader::Close)
-        .def_property_readonly("path", &FileReader::FilePath)
+    py::enum_<las::Dimension>(m, "Dimension", py::arithmetic())
+        .value("XYZ", las::Dimension::DIM_XYZ)
+        .value("INTENSITY", las::Dimension::DIM_INTENSITY)
+        .value("RETURNS", las::Dimension::DIM_RETURNS)
+        .value("FLAGS", las::Dimension::DIM_FLAGS)
+        .value("CLASSIFICATION", las::Dimension::DIM_CLASSIFICATION)
+        .value("USER_DATA", las::Dimension::DIM_USER_DATA)
+        .value("SCAN_ANGLE", las::Dimension::DIM_SCAN_ANGLE)
+        .value("POINT_SOURCE_ID", las::Dimension::DIM_POINT_SOURCE_ID)
+        .value("GPS_TIME", las::Dimension::DIM_GPS_TIME)
+        .value("RGB", las::Dimension::DIM_RGB)
+        .value("NIR", las::Dimension::DIM_NIR)
+        .value("EXTRA_BYTES", las::Dimension::DIM_EXTRA_BYTES)
+        .value("ALL", las::Dimension::DIM_ALL);
+
+    py::class_<las::PointBuffer> point_buffer(m, "PointBuffer");
+    point_buffer
+        .def(py::init<const int8_t &, const uint16_t &, const uint32_t &>(), py::arg("point_format_id"),
+             py::arg("eb_byte_size") = 0, py::arg("dimensions") = static_cast<uint32_t>(las::Dimension::DIM_ALL))
+        .def(py::init<const las::LasHeader &, const uint32_t &>(), py::arg("header"),
+             py::arg("dimensions") = static_cast<uint32_t>(las::Dimension::DIM_ALL))
+        .def(py::init<const las::Points &>(), py::arg("points"))
+        .def_property_readonly("point_format_id", &las::PointBuffer::PointFormatId)
+        .def_property_readonly("point_record_length", &las::PointBuffer::PointRecordLength)
+        .def_property_readonly("eb_byte_size", &las::PointBuffer::EbByteSize)
+        .def_property_readonly("has_rgb", &las::PointBuffer::HasRgb)
+        .def_property_readonly("has_nir", &las::PointBuffer::HasNir)
+        .def_property_readonly("dimensions", &las::PointBuffer::Dimensions)
+        .def("HasDimension", &las::PointBuffer::HasDimension, py::arg("dimension"))
+        .def("HasAllDimensions", &las::PointBuffer::HasAllDimensions)
+        .def(
+            "Resize",
+            [](las::PointBuffer &self, const size_t &size)
+            {
+                CheckNoPointBufferViews(self);
+                self.Resize(size);
+            },
+            py::arg("size"))
+        .def(
+            "AddPoint",
+            [](las::PointBuffer &self, const las::Point &point)
+            {
+                CheckNoPointBufferViews(self);
+                self.AddPoint(point);
+            },
+            py::arg("point"))
+        .def(
+            "AddPoints",
+            [](las::PointBuffer &self, const las::PointBuffer &points)
+            {
+                CheckNoPointBufferViews(self);
+                self.AddPoints(points);
+            },
+            py::arg("points"))
+        .def("GetPoint", &las::PointBuffer::GetPoint, py::arg("index"))
+        .def("ToPoints", &las::PointBuffer::ToPoints)
+        .def("Within", &las::PointBuffer::Within, py::arg("box"))
+        .def("GetWithin", &las::PointBuffer::GetWithin, py::arg("box"))
+        .def("GetSubset", &las::PointBuffer::GetSubset, py::arg("mask"))
+        .def("Pack", py::overload_cast<const Vector3 &, const Vector3 &>(&las::PointBuffer::Pack, py::const_))
+        .def("Pack", py::overload_cast<const las::LasHeader &>(&las::PointBuffer::Pack, py::const_))
+        .def_static("Unpack",
+                    py::overload_cast<const std::vector<char> &, const las::LasHeader &, const uint32_t &>(
+                        &las::PointBuffer::Unpack),
+                    py::arg("point_data"), py::arg("header"),
+                    py::arg("dimensions") = static_cast<uint32_t>(las::Dimension::DIM_ALL))
+        .def("__len__", &las::PointBuffer::Size)
+        .def("__str__", &las::PointBuffer::ToString)
+        .def("__repr__", &las::PointBuffer::ToString);
+    DefPointBufferColumn<double>(point_buffer, "x", &las::PointBuffer::X);
+    DefPointBufferColumn<double>(point_buffer, "y", &las::PointBuffer::Y);
+    DefPointBufferColumn<double>(point_buffer, "z", &las::PointBuffer::Z);
+    DefPointBufferColumn<uint16_t>(point_buffer, "intensity", &las::PointBuffer::Intensity);
+    DefPointBufferColumn<uint8_t>(point_buffer, "returns_bit_field", &las::PointBuffer::ReturnsBitField);
+    DefPointBufferColumn<uint8_t>(point_buffer, "flags_bit_field", &las::PointBuffer::FlagsBitField);
+    DefPointBufferColumn<uint8_t>(point_buffer, "classification", &las::PointBuffer::Classification);
+    DefPointBufferColumn<uint8_t>(point_buffer, "user_data", &las::PointBuffer::UserData);
+    DefPointBufferColumn<int16_t>(point_buffer, "scan_angle", &las::PointBuffer::ScanAngle);
+    DefPointBufferColumn<uint16_t>(point_buffer, "point_source_id", &las::PointBuffer::PointSourceId);
+    DefPointBufferColumn<double>(point_buffer, "gps_time", &las::PointBuffer::GPSTime);
+    DefPointBufferColumn<uint16_t>(point_buffer, "red", &las::PointBuffer::Red);
+    DefPointBufferColumn<uint16_t>(point_buffer, "green", &las::PointBuffer::Green);
+    DefPointBufferColumn<uint16_t>(point_buffer, "blue", &las::PointBuffer::Blue);
+    DefPointBufferColumn<uint16_t>(point_buffer, "nir", &las::PointBuffer::Nir);
+    DefPointBufferColumn<uint8_t>(point_buffer, "extra_bytes", &las::PointBuffer::ExtraBytes);
+
+    py::enum_<PointField>(m, "PointField")
+        .value("X", PointField::FIELD_X)
+        .value("Y", PointField::FIELD_Y)
+        .value("Z", PointField::FIELD_Z)
+        .value("INTENSITY", PointField::FIELD_INTENSITY)
+        .value("RETURN_NUMBER", PointField::FIELD_RETURN_NUMBER)
+        .value("NUMBER_OF_RETURNS", PointField::FIELD_NUMBER_OF_RETURNS)
+        .value("SCANNER_CHANNEL", PointField::FIELD_SCANNER_CHANNEL)
+        .value("SCAN_DIRECTION_FLAG", PointField::FIELD_SCAN_DIRECTION_FLAG)
+        .value("EDGE_OF_FLIGHT_LINE", PointField::FIELD_EDGE_OF_FLIGHT_LINE)
+        .value("CLASSIFICATION", PointField::FIELD_CLASSIFICATION)
+        .value("USER_DATA", PointField::FIELD_USER_DATA)
+        .value("SCAN_ANGLE", PointField::FIELD_SCAN_ANGLE)
+        .value("POINT_SOURCE_ID", PointField::FIELD_POINT_SOURCE_ID)
+        .value("GPS_TIME", PointField::FIELD_GPS_TIME)
+        .value("RED", PointField::FIELD_RED)
+        .value("GREEN", PointField::FIELD_GREEN)
+        .value("BLUE", PointField::FIELD_BLUE)
+        .value("NIR", PointField::FIELD_NIR);
+
+    py::class_<NodeStats>(m, "NodeStats")
+        .def(py::init<>())
+        .def_static("FromPoints", &NodeStats::FromPoints, py::arg("points"))
+        .def("Merge", &NodeStats::Merge, py::arg("other"))
+        .def_property_readonly("point_count", &NodeStats::PointCount)
+        .def("HasField", &NodeStats::HasField, py::arg("field"))
+        .def("Minimum", &NodeStats::Minimum, py::arg("field"))
+        .def("Maximum", &NodeStats::Maximum, py::arg("field"))
+        .def("ClassificationCount", &NodeStats::ClassificationCount, py::arg("classification"))
+        .def_property_readonly("classification_counts", &NodeStats::ClassificationCounts)
+        .def("__str__", &NodeStats::ToString)
+        .def("__repr__", &NodeStats::ToString);
+
+    py::class_<ExtentsAccumulator>(m, "ExtentsAccumulator")
+        .def(py::init<>())
+        .def("Add", &ExtentsAccumulator::Add, py::arg("points"))
+        .def("Merge", &ExtentsAccumulator::Merge, py::arg("other"))
+        .def_property_readonly("point_count", &ExtentsAccumulator::PointCount)
+        .def("HasField", &ExtentsAccumulator::HasField, py::arg("field"))
+        .def("Extent", &ExtentsAccumulator::Extent, py::arg("field"))
+        .def("Apply", &ExtentsAccumulator::Apply, py::arg("extents"))
+        .def("ApplyBounds", &ExtentsAccumulator::ApplyBounds, py::arg("header"))
+        .def("__str__", &ExtentsAccumulator::ToString)
+        .def("__repr__", &ExtentsAccumulator::ToString);
+
+    py::class_<PointFilter>(m, "PointFilter")
+        .def(py::init<>())
+        .def("Range", &PointFilter::Range, py::arg("field"), py::arg("minimum"), py::arg("maximum"),
+             py::return_value_policy::reference_internal)
+        .def("In", &PointFilter::In, py::arg("field"), py::arg("values"), py::return_value_policy::reference_internal)
+        .def("Empty", &PointFilter::Empty)
+        .def_property_readonly("required_dimensions", &PointFilter::RequiredDimensions)
+        .def("MayMatch", &PointFilter::MayMatch, py::arg("stats"))
+        .def("Mask", &PointFilter::Mask, py::arg("points"))
+        .def("Apply", &PointFilter::Apply, py::arg("points"))
+        .def("__str__", &PointFilter::ToString)
+        .def("__repr__", &PointFilter::ToString);
+
+    py::class_<NodeCacheStats>(m, "NodeCacheStats")
+        .def_readonly("hits", &NodeCacheStats::hits)
+        .def_readonly("misses", &NodeCacheStats::misses)
+        .def_readonly("evictions", &NodeCacheStats::evictions)
+        .def_readonly("node_count", &NodeCacheStats::node_count)
+        .def_readonly("bytes", &NodeCacheStats::bytes)
+        .def_readonly("max_bytes", &NodeCacheStats::max_bytes);
+
+    py::class_<PointCursor>(m, "PointCursor")
+        .def(
+            "__iter__", [](PointCursor &cursor) -> PointCursor & { return cursor; },
+            py::return_value_policy::reference_internal)
+        .def("__next__",
+             [](PointCursor &cursor)
+             {
+                 las::Points points(cursor.LasHeader());
+                 bool found;
+                 {
+                     py::gil_scoped_release release;
+                     found = cursor.Next(points);
+                 }
+                 if (!found)
+                     throw py::stop_iteration();
+                 return points;
+             })
+        .def_property_readonly("current_node", &PointCursor::CurrentNode)
+        .def_property_readonly("node_count", &PointCursor::NodeCount)
+        .def_property_readonly("nodes_read", &PointCursor::NodesRead);
+
+    // The reader methods are bound once on the base class, and inherited by every kind of reader
+    py::class_<Reader>(m, "Reader")
         .def("FindNode", &Reader::FindNode, py::arg("key"))
         .def_property_readonly("copc_config", &Reader::CopcConfig)
         .def("GetPointData", py::overload_cast<const Node &>(&Reader::GetPointData), py::arg("node"))
+        .def("GetPointData", py::overload_cast<const Node &, std::vector<char> &>(&Reader::GetPointData),
+             py::arg("node"), py::arg("out"))
+        .def("PointDataSize", &Reader::PointDataSize, py::arg("node"))
         .def("GetPointData", py::overload_cast<const VoxelKey &>(&Reader::GetPointData), py::arg("key"))
         .def("GetPoints", py::overload_cast<const Node &>(&Reader::GetPoints), py::arg("node"))
         .def("GetPoints", py::overload_cast<const VoxelKey &>(&Reader::GetPoints), py::arg("key"))
+        .def("GetPoints", py::overload_cast<const std::vector<Node> &, unsigned int>(&Reader::GetPoints),
+             py::arg("nodes"), py::arg("num_threads") = 0, py::call_guard<py::gil_scoped_release>())
+        .def("GetPointBuffer", py::overload_cast<const Node &, uint32_t>(&Reader::GetPointBuffer), py::arg("node"),
+             py::arg("dimensions") = static_cast<uint32_t>(las::Dimension::DIM_ALL))
+        .def("GetPointBuffer", py::overload_cast<const VoxelKey &, uint32_t>(&Reader::GetPointBuffer), py::arg("key"),
+             py::arg("dimensions") = static_cast<uint32_t>(las::Dimension::DIM_ALL))
+        .def("GetPointBuffers", &Reader::GetPointBuffers, py::arg("nodes"),
+             py::arg("dimensions") = static_cast<uint32_t>(las::Dimension::DIM_ALL), py::arg("num_threads") = 0,
+             py::call_guard<py::gil_scoped_release>())
         .def("GetPointDataCompressed", py::overload_cast<const Node &>(&Reader::GetPointDataCompressed),
              py::arg("node"))
         .def("GetPointDataCompressed", py::overload_cast<const VoxelKey &>(&Reader::GetPointDataCompressed),
@@ -399,15 +691,47 @@ PYBIND11_MODULE(_core, m)
         .def("GetAllChildrenOfPage", &Reader::GetAllChildrenOfPage, py::arg("key"))
         .def("GetAllNodes", &Reader::GetAllNodes)
         .def("GetPageList", &Reader::GetPageList)
-        .def("GetAllPoints", &Reader::GetAllPoints, py::arg("resolution") = 0)
+        .def("LoadHierarchy", &Reader::LoadHierarchy, py::arg("num_threads") = 1,
+             py::call_guard<py::gil_scoped_release>())
+        .def("GetAllPoints", &Reader::GetAllPoints, py::arg("resolution") = 0, py::arg("num_threads") = 0,
+             py::call_guard<py::gil_scoped_release>())
         .def("GetNodesWithinBox", &Reader::GetNodesWithinBox, py::arg("box"), py::arg("resolution") = 0)
         .def("GetNodesIntersectBox", &Reader::GetNodesIntersectBox, py::arg("box"), py::arg("resolution") = 0)
-        .def("GetPointsWithinBox", &Reader::GetPointsWithinBox, py::arg("box"), py::arg("resolution") = 0)
+        .def("GetPointsWithinBox", &Reader::GetPointsWithinBox, py::arg("box"), py::arg("resolution") = 0,
+             py::arg("num_threads") = 0, py::call_guard<py::gil_scoped_release>())
+        .def("QueryPointsWithinBox", &Reader::QueryPointsWithinBox, py::arg("box"), py::arg("resolution") = 0,
+             py::arg("prefetch") = 0, py::keep_alive<0, 1>())
         .def("GetDepthAtResolution", &Reader::GetDepthAtResolution, py::arg("resolution"))
         .def("GetMaxDepth", &Reader::GetMaxDepth)
         .def("GetNodesAtResolution", &Reader::GetNodesAtResolution, py::arg("resolution"))
         .def("GetNodesWithinResolution", &Reader::GetNodesWithinResolution, py::arg("resolution"))
-        .def("ValidateSpatialBounds", &Reader::ValidateSpatialBounds, py::arg("verbose") = false);
+        .def("ValidateSpatialBounds", &Reader::ValidateSpatialBounds, py::arg("verbose") = false)
+        .def("HasNodeStats", &Reader::HasNodeStats)
+        .def("GetNodeStats", &GetNodeStats, py::arg("key"))
+        .def("GetNodesWithFilter", &Reader::GetNodesWithFilter, py::arg("filter"), py::arg("box") = Box::MaxBox(),
+             py::arg("resolution") = 0)
+        .def("GetPointsWithFilter", &Reader::GetPointsWithFilter, py::arg("filter"), py::arg("box") = Box::MaxBox(),
+             py::arg("resolution") = 0, py::arg("dimensions") = static_cast<uint32_t>(las::Dimension::DIM_ALL),
+             py::arg("num_threads") = 0, py::call_guard<py::gil_scoped_release>())
+        .def("EnableNodeCache", &Reader::EnableNodeCache, py::arg("max_bytes"))
+        .def("ClearNodeCache", &Reader::ClearNodeCache)
+        .def("GetNodeCacheStats", &Reader::GetNodeCacheStats);
+
+    py::class_<FileReader, Reader>(m, "FileReader")
+        .def(py::init<std::string &>())
+        .def("Close", &FileReader::Close)
+        .def_property_readonly("path", &FileReader::FilePath);
+
+    py::class_<MmapReader, Reader>(m, "MmapReader")
+        .def(py::init<std::string &>())
+        .def("Close", &MmapReader::Close)
+        .def_property_readonly("path", &MmapReader::FilePath)
+        .def_property_readonly("file_size", &MmapReader::FileSize);
+
+    py::class_<PreadReader, Reader>(m, "PreadReader")
+        .def(py::init<std::string &>())
+        .def("Close", &PreadReader::Close)
+        .def_property_readonly("path", &PreadReader::FilePath);
 
     py::class_<las::EbVlr>(m, "EbVlr").def(py::init<int>()).def_readwrite("items", &las::EbVlr::items);
 
@@ -425,12 +749,21 @@ PYBIND11_MODULE(_core, m)
         .def("Close", &FileWriter::Close)
         .def("AddNode", py::overload_cast<const VoxelKey &, const las::Points &, const VoxelKey &>(&Writer::AddNode),
              py::arg("key"), py::arg("points"), py::arg("page_key") = VoxelKey::RootKey())
+        .def("AddNode",
+             py::overload_cast<const VoxelKey &, const las::PointBuffer &, const VoxelKey &>(&Writer::AddNode),
+             py::arg("key"), py::arg("points"), py::arg("page_key") = VoxelKey::RootKey())
         .def("AddNodeCompressed", &Writer::AddNodeCompressed, py::arg("key"), py::arg("compressed_data"),
              py::arg("point_count"), py::arg("page_key") = VoxelKey::RootKey())
         .def("AddNode",
              py::overload_cast<const VoxelKey &, std::vector<char> const &, const VoxelKey &>(&Writer::AddNode),
              py::arg("key"), py::arg("uncompressed_data"), py::arg("page_key") = VoxelKey::RootKey())
-        .def("ChangeNodePage", &Writer::ChangeNodePage, py::arg("node_key"), py::arg("new_page_key"));
+        .def("ChangeNodePage", &Writer::ChangeNodePage, py::arg("node_key"), py::arg("new_page_key"))
+        .def("EnableParallelCompression", &Writer::EnableParallelCompression, py::arg("num_threads") = 0,
+             py::arg("max_bytes_in_flight") = Writer::DEFAULT_MAX_BYTES_IN_FLIGHT)
+        .def("Flush", &Writer::Flush, py::call_guard<py::gil_scoped_release>())
+        .def("EnableNodeStats", &Writer::EnableNodeStats, py::arg("enable") = true)
+        .def("EnableAutoExtents", &Writer::EnableAutoExtents, py::arg("enable") = true)
+        .def("AccumulatedExtents", &Writer::AccumulatedExtents);
 
     py::class_<laz::LazFileReader>(m, "LazReader")
         .def(py::init<const std::string &>(), py::arg("file_path"))
@@ -447,7 +780,9 @@ PYBIND11_MODULE(_core, m)
         .def("Close", &laz::LazFileWriter::Close)
         .def("WritePoints", py::overload_cast<const las::Points &>(&laz::LazWriter::WritePoints), py::arg("points"))
         .def("WritePointsCompressed", &laz::LazWriter::WritePointsCompressed, py::arg("compressed_data"),
-             py::arg("point_count"));
+             py::arg("point_count"))
+        .def("EnableAutoExtents", &laz::LazWriter::EnableAutoExtents, py::arg("enable") = true)
+        .def("AccumulatedExtents", &laz::LazWriter::AccumulatedExtents);
 
     m.def(
         "CompressBytes",
@@ -455,6 +790,11 @@ PYBIND11_MODULE(_core, m)
         py::arg("in"), py::arg("point_format_id"), py::arg("eb_byte_size"));
     m.def("CompressBytes",
           py::overload_cast<std::vector<char> &, const las::LasHeader &>(&laz::Compressor::CompressBytes));
+    m.def("CompressPoints",
+          py::overload_cast<const std::vector<las::Points> &, const las::LasHeader &, unsigned int,
+                            ExtentsAccumulator *>(&laz::Compressor::CompressPoints),
+          py::arg("points"), py::arg("header"), py::arg("num_threads") = 0, py::arg("extents") = nullptr,
+          py::call_guard<py::gil_scoped_release>());
 
     m.def("DecompressBytes",
           py::overload_cast<const std::vector<char> &, const las::LasHeader &, const int &>(
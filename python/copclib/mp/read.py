@@ -2,11 +2,24 @@ from .utils import chunks
 import copclib as copc
 import numpy as np
 
-import concurrent.futures
 
-# Initialize each multiprocessing thread with a copy of the copc reader
-def init_mp(copc_path):
-    _read_node.copc_reader = copc.FileReader(copc_path)
+def _get_nodes(reader, nodes, resolution, progress):
+    """Returns the nodes to process: either the provided list of nodes, or the nodes within the given resolution."""
+    if nodes is not None and resolution > -1:
+        raise RuntimeError("You can only specify one of: 'nodes', 'resolution'")
+
+    # Sets the nodes to iterate over, if none are provided
+    if nodes is None:
+        if resolution > -1:
+            nodes = reader.GetNodesWithinResolution(resolution)
+        else:
+            nodes = reader.GetAllNodes()
+
+        # Reset the progress bar to the new total number of nodes
+        if progress is not None:
+            progress.reset(len(nodes))
+
+    return nodes
 
 
 def read_multithreaded(
@@ -22,87 +35,34 @@ def read_multithreaded(
 ):
     """Scaffolding for reading COPC files in a multithreaded way to increase performance.
     It queues all nodes from either the provided list of nodes or nodes within the given resolution to be processed.
-    Within the multiprocess, `read_function` is called with `read_function_args` keyword arguments, as well as the
+    The nodes are decompressed and unpacked a chunk at a time on the reader's native thread pool, which runs
+        without holding the GIL, so no process pool or pickling is involved.
+    For each node, `read_function` is called with `read_function_args` keyword arguments, as well as the
         keyword arguments "points", "node", and "reader".
-        This function should take those parameters and return a pickleable object that represents those points -
+        This function should take those parameters and return an object that represents those points -
             for example, a list of XYZ points limited by classification.
         Note that whatever is returned from this function must be wrapped in a dictionary,
             because the return values get passed as keyword arguments to `callback_function`.
-    The return value of `read_function`, as well as the currently processed node, is passed back to the main thread,
-        where `callback_function` is called with the node and the return values of `read_function` as keyword arguments.
-        This function can aggregate your results as they back from the multithreading.
+    The return value of `read_function`, as well as the currently processed node, is then passed to
+        `callback_function` as keyword arguments. This function can aggregate your results as they come back.
 
     Args:
         reader (copclib.CopcReader): A copc reader for the file you are reading
         read_function (function): A function which takes each input node and its points and
-            returns a pickleable object as output.
+            returns an object as output.
         read_function_args (dict, optional): A key/value pair of keyword arguments to pass to the read_function. Defaults to {}.
         nodes (list[copc.Node], optional): A list of nodes to run the reader on. Defaults to reading all the nodes.
         resolution (float, optional): If a list of nodes is not provided, reads all nodes up to this resolution.
             Defaults to reading all nodes.
         progress (tqdm.tqdm, optional): A TQDM progress bar to track progress. Defaults to None.
-        completed_callback (function, optional): A function which is called after a node is processed
-            and returned from multiprocessing. Defaults to None.
-        chunk_size (int, optional): Limits the amount of nodes which are queued for multiprocessing at once. Defaults to 1024.
-        max_workers (int, optional): Manually set the number of processors to use when multiprocessing. Defaults to all processors.
+        completed_callback (function, optional): A function which is called after a node is processed. Defaults to None.
+        chunk_size (int, optional): Limits the amount of nodes which are decompressed at once. Defaults to 1024.
+        max_workers (int, optional): Manually set the number of threads to decompress with. Defaults to all processors.
 
     Raises:
         RuntimeError
     """
-    if nodes is not None and resolution > -1:
-        raise RuntimeError("You can only specify one of: 'nodes', 'resolution'")
-
-    # Sets the nodes to iterate over, if none are provided
-    if nodes is None:
-        if resolution > -1:
-            nodes = reader.GetNodesWithinResolution(resolution)
-        else:
-            nodes = reader.GetAllNodes()
-
-        # Reset the progress bar to the new total number of nodes
-        if progress is not None:
-            progress.reset(len(nodes))
-
-    # Initialize the multiprocessing
-    with concurrent.futures.ProcessPoolExecutor(
-        max_workers=max_workers,
-        initializer=init_mp,
-        initargs=(reader.path,),
-    ) as executor:
-        # Chunk the nodes so we're not flooding executor.submit
-        for chunk in chunks(nodes, chunk_size):
-            futures = []
-            # Call _read_node, which calls the read_function
-            for node in chunk:
-                future = executor.submit(
-                    _read_node,
-                    read_function,
-                    read_function_args,
-                    node,
-                )
-                # Update the progress bar, if necessary
-                if progress is not None:
-                    future.add_done_callback(lambda _: progress.update())
-                futures.append(future)
-
-            # As each node completes
-            for fut in concurrent.futures.as_completed(futures):
-                node, return_vals = fut.result()
-                # Call competed_callback if provided
-                if completed_callback:
-                    completed_callback(
-                        node=node,
-                        **return_vals,
-                    )
-
-
-def _read_node(read_function, read_function_args, node):
-    """Helper function which gets called by executor.submit in the multiprocessing.
-    Calls read_function and returns the results.
-    """
-    reader = _read_node.copc_reader
-    # Decompress and unpack the points within each thread
-    points = reader.GetPoints(node)
+    nodes = _get_nodes(reader, nodes, resolution, progress)
 
     # If any of these arguments are provided, they'll throw an error since we use those argument names
     for argument_name in read_function_args.keys():
@@ -111,36 +71,87 @@ def _read_node(read_function, read_function_args, node):
             "node",
             "reader",
         ], f"Use of protected keyword argument '{argument_name}'!"
-    # Actually call the read_function
-    ret = read_function(points=points, node=node, reader=reader, **read_function_args)
-    assert isinstance(
-        ret, dict
-    ), "The read_function return value should be a dictionary of kwargs!"
-
-    return node, ret
 
+    for chunk in chunks(nodes, chunk_size):
+        # Decompress and unpack the chunk's points on the native thread pool
+        chunk_points = reader.GetPoints(chunk, num_threads=max_workers or 0)
+        for node, points in zip(chunk, chunk_points):
+            # Actually call the read_function
+            return_vals = read_function(
+                points=points, node=node, reader=reader, **read_function_args
+            )
+            assert isinstance(
+                return_vals, dict
+            ), "The read_function return value should be a dictionary of kwargs!"
+
+            # Update the progress bar, if necessary
+            if progress is not None:
+                progress.update()
+            # Call competed_callback if provided
+            if completed_callback:
+                completed_callback(
+                    node=node,
+                    **return_vals,
+                )
 
-def _do_read_xyz(points, class_limits=None, **kwargs):
-    """A 'read_function' which returns a numpy array of XYZ points from the COPC file,
-    optionally limiting to certain classifications.
 
-    Args:
-        points (copc.Points): The decompressed and unpacked Points from the given node
-        class_limits (list[int], optional): Limits the points returned to those whose
-            classification. Defaults to None.
-
-    Returns:
-        dict(xyz=np.array): The numpy array of points, with "xyz" as their kwarg key
+def _buffer_xyz(buffer, class_limits=None):
+    """Returns an (Nx3) numpy array of the XYZ coordinates of a PointBuffer,
+    optionally limited to certain classifications.
     """
-    xyzs = []
-    # Iterate over each point in the node and check if it's
-    # within the provided classificaiton limits
-    for point in points:
-        if not class_limits or point.classification in class_limits:
-            xyzs.append([point.x, point.y, point.z])
+    xyz = np.column_stack((buffer.x_array, buffer.y_array, buffer.z_array))
+
+    # Only keep the points within the provided classification limits
+    if class_limits:
+        xyz = xyz[np.isin(buffer.classification_array, class_limits)]
 
     # Reshape to always be (Nx3), in case there's no points
-    return dict(xyz=np.array(xyzs).reshape(len(xyzs), 3))
+    return xyz.reshape(len(xyz), 3)
+
+
+def _node_may_match(reader, node, point_filter):
+    """Returns False if the node's statistics show that none of its points pass the filter."""
+    stats = reader.GetNodeStats(node.key)
+    return stats is None or point_filter.MayMatch(stats)
+
+
+def _read_xyz_multithreaded(
+    reader,
+    class_limits=None,
+    nodes=None,
+    resolution=-1,
+    progress=None,
+    chunk_size=1024,
+    max_workers=None,
+):
+    """Decompresses the XYZ and classification of each node straight into columns on the reader's
+    native thread pool, and yields each node with an (Nx3) numpy array of its XYZ coordinates.
+    Nodes whose statistics show they have none of the classes in `class_limits` aren't decompressed or yielded.
+    """
+    nodes = _get_nodes(reader, nodes, resolution, progress)
+    dimensions = copc.Dimension.XYZ | copc.Dimension.CLASSIFICATION
+    point_filter = None
+    if class_limits:
+        point_filter = copc.PointFilter().In(
+            copc.PointField.CLASSIFICATION, class_limits
+        )
+
+    for chunk in chunks(nodes, chunk_size):
+        if point_filter is not None:
+            matching = [
+                node for node in chunk if _node_may_match(reader, node, point_filter)
+            ]
+            if progress is not None:
+                progress.update(len(chunk) - len(matching))
+            chunk = matching
+
+        buffers = reader.GetPointBuffers(
+            chunk, dimensions, num_threads=max_workers or 0
+        )
+        for node, buffer in zip(chunk, buffers):
+            if progress is not None:
+                progress.update()
+            yield node, _buffer_xyz(buffer, class_limits)
 
 
 def read_concat_xyz_class_limit(
@@ -172,22 +183,18 @@ def read_concat_xyz_class_limit(
             raise RuntimeError(f"Invalid kwarg '{invalid_arg}'!")
 
     # Container of all XYZ points
-    all_xyz = []
+    all_xyz = [np.empty((0, 3))]
 
     # After each node is done, add the array of that node's XYZ coordinates
     # to our container
-    def callback(xyz, **kwargs):
-        all_xyz.append(xyz)
-
-    read_multithreaded(
-        reader=reader,
-        read_function=_do_read_xyz,
-        read_function_args=dict(class_limits=classification_limits),
-        completed_callback=callback,
+    for _, xyz in _read_xyz_multithreaded(
+        reader,
+        class_limits=classification_limits,
         resolution=resolution,
         progress=progress,
         **kwargs,
-    )
+    ):
+        all_xyz.append(xyz)
 
     # Concatenate all the points in the end, and return one large array of
     # all the points in the file
@@ -228,18 +235,14 @@ def read_map_xyz_class_limit(
 
     # After each node is done processing, add the returned coordinates
     # to the map
-    def callback(xyz, node, **kwargs):
-        if len(xyz) > 0:
-            key_xyz_map[str(node.key)] = xyz
-
-    read_multithreaded(
+    for node, xyz in _read_xyz_multithreaded(
         reader,
-        read_function=_do_read_xyz,
-        read_function_args=dict(class_limits=classification_limits),
-        completed_callback=callback,
+        class_limits=classification_limits,
         resolution=resolution,
         progress=progress,
         **kwargs,
-    )
+    ):
+        if len(xyz) > 0:
+            key_xyz_map[str(node.key)] = xyz
 
     return key_xyz_map
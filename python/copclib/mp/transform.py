@@ -2,21 +2,12 @@ from typing import Any, Callable, Dict, List, Optional, Union
 from .utils import chunks
 import copclib as copc
 
-import concurrent.futures
-
 
 def _copy_points_transform(points, **kwargs):
     """A default transform_function which simply copies the points directly over."""
     return points
 
 
-# Initialize each multiprocessing thread with a copy of the copc reader
-def init_mp(copc_path, mp_init_function, mp_init_function_args):
-    _transform_node.copc_reader = copc.FileReader(copc_path)
-    if mp_init_function:
-        mp_init_function(**mp_init_function_args)
-
-
 def transform_multithreaded(
     reader: copc.FileReader,
     writer: Union[copc.FileWriter, copc.LazWriter],
@@ -34,16 +25,17 @@ def transform_multithreaded(
 ):
     """Scaffolding for reading COPC files and writing them back out in a multithreaded way.
     It queues all nodes from either the provided list of nodes or nodes within the given resolution to be processed.
-    Within the multiprocess, `transform_function` is called with `transform_function_args` keyword arguments, as well as the
+    The nodes are decompressed, and the transformed points compressed, a chunk at a time on native thread pools
+        which run without holding the GIL, so no process pool or pickling is involved.
+    For each node, `transform_function` is called with `transform_function_args` keyword arguments, as well as the
         keyword arguments "points", "node", "writer_header", and "reader".
         This function should take those parameters and return a copclib.Points object, and optionally a dictionary of
             return values which will be passed to the callback function.
-    The points returned by the transform_function are passed back to the main thread, where those points
-        are written out to the `writer`.
-    Optionally, the `completed_callback` is called in the main thread with the dictionary of keyword arguments returned from
-        the `transform_function` as arguments. This allows tracking values from the points and bringing them back to the main
-        thread for further processing if needed (for example, finding the maximum intensity value that gets written).
-    Optionally, the header of the LAS file is updated with the new XYZ extents.
+    The points returned by the transform_function are compressed and written out to the `writer`.
+    Optionally, the `completed_callback` is called with the dictionary of keyword arguments returned from
+        the `transform_function` as arguments. This allows tracking values from the points for further processing
+        if needed (for example, finding the maximum intensity value that gets written).
+    Optionally, the header of the LAS file is updated with the XYZ extents of the written points.
 
     Args:
         reader (copclib.CopcReader): A copc reader for the file you are reading
@@ -56,13 +48,13 @@ def transform_multithreaded(
         resolution (float, optional): If a list of nodes is not provided, reads all nodes up to this resolution.
             Defaults to reading all nodes.
         progress (tqdm.tqdm, optional): A TQDM progress bar to track progress. Defaults to None.
-        completed_callback (function, optional): A function which is called after a node is processed
-            and returned from multiprocessing. Defaults to None.
-        chunk_size (int, optional): Limits the amount of nodes which are queued for multiprocessing at once. Defaults to 1024.
-        max_workers (int, optional): Manually set the number of processors to use when multiprocessing. Defaults to all processors.
+        completed_callback (function, optional): A function which is called after a node is processed. Defaults to None.
+        chunk_size (int, optional): Limits the amount of nodes which are processed at once. Defaults to 1024.
+        max_workers (int, optional): Manually set the number of threads to (de)compress with. Defaults to all processors.
         update_minmax (bool, optional): If true, updates the header of the output file with the correct XYZ min/max.
+            The COPC extents are left as they are, use the writer's EnableAutoExtents to compute them too.
             Defaults to False.
-        mp_init_function: (function, optional): A function that gets called in the ProcessPoolExeuctor initializer
+        mp_init_function: (function, optional): A function that gets called once, before any node is processed
         mp_init_function_args: (dict, optional): A key/value pair of keyword arguments that get passed to `mp_init_function`.
             Defaults to {}.
 
@@ -94,91 +86,8 @@ def transform_multithreaded(
     else:
         raise RuntimeError(f"Unknown writer type: {writer}")
 
-    # keep track of all the mins and maxs
-    all_mins = []
-    all_maxs = []
-    # Initialize the multiprocessing
-    with concurrent.futures.ProcessPoolExecutor(
-        max_workers=max_workers,
-        initializer=init_mp,
-        initargs=(reader.path, mp_init_function, mp_init_function_args),
-    ) as executor:
-        # Chunk the nodes so we're not flooding executor.submit
-        for chunk in chunks(nodes, chunk_size):
-            futures = []
-            for node in chunk:
-                # Call _transform_node, which calls the transform_function
-                future = executor.submit(
-                    _transform_node,
-                    transform_function,
-                    transform_function_args,
-                    node,
-                    writer_header,
-                    update_minmax,
-                )
-                # Update the progress bar, if necessary
-                if progress is not None:
-                    future.add_done_callback(lambda _: progress.update())
-                futures.append(future)
-
-            # As each node completes
-            for fut in concurrent.futures.as_completed(futures):
-                (
-                    compressed_points,
-                    node,
-                    point_count,
-                    xyz_min,
-                    xyz_max,
-                    return_vals,
-                ) = fut.result()
-                # Call competed_callback if provided
-                if completed_callback:
-                    completed_callback(
-                        node=node,
-                        point_count=point_count,
-                        compressed_points=compressed_points,
-                        **return_vals,
-                    )
-
-                if point_count > 0:
-                    # Add the min/max of each node to the list
-                    if xyz_min and xyz_max:
-                        all_mins.append(xyz_min)
-                        all_maxs.append(xyz_max)
-
-                    # Write the node out
-                    if isinstance(writer, copc.FileWriter):
-                        writer.AddNodeCompressed(
-                            node.key,
-                            compressed_points,
-                            point_count,
-                            node.page_key,
-                        )
-                    elif isinstance(writer, copc.LazWriter):
-                        writer.WritePointsCompressed(compressed_points, point_count)
-
-    # Compute the global min/max of all the nodes and update the LAS header, if necessary
-    if update_minmax:
-        global_min = global_max = [0, 0, 0]
-        if len(all_mins) > 0 and len(all_maxs) > 0:
-            import numpy as np
-
-            global_min = np.min(all_mins, axis=0)
-            global_max = np.max(all_maxs, axis=0)
-
-        writer_header.min = list(global_min)
-        writer_header.max = list(global_max)
-
-
-def _transform_node(
-    transform_function, transform_function_args, node, writer_header, update_minmax
-):
-    """Helper function that gets called by executor.submit in the multiprocess.
-    Calls transform_function and keeps track of the min/max XYZ in case they need to be updated.
-    """
-    reader = _transform_node.copc_reader
-    # Decompress and unpack the points within each thread
-    points = reader.GetPoints(node)
+    if mp_init_function:
+        mp_init_function(**mp_init_function_args)
 
     # If any of these arguments are provided, they'll throw an error since we use those argument names
     for argument_name in transform_function_args.keys():
@@ -188,6 +97,75 @@ def _transform_node(
             "writer_header",
             "reader",
         ], f"Use of protected keyword argument '{argument_name}'!"
+
+    # The extents are accumulated from the transformed points as they're compressed, on the same native threads
+    extents = copc.ExtentsAccumulator() if update_minmax else None
+
+    num_threads = max_workers or 0
+    for chunk in chunks(nodes, chunk_size):
+        # Decompress and unpack the chunk's points on the native thread pool
+        chunk_points = reader.GetPoints(chunk, num_threads=num_threads)
+
+        # Call _transform_node, which calls the transform_function
+        results = [
+            _transform_node(
+                transform_function,
+                transform_function_args,
+                node,
+                points,
+                reader,
+                writer_header,
+            )
+            for node, points in zip(chunk, chunk_points)
+        ]
+
+        # Repack and compress the points using the new writer header
+        compressed_chunk = copc.CompressPoints(
+            [points for points, _ in results], writer_header, num_threads, extents
+        )
+
+        for node, compressed_points, (points, return_vals) in zip(
+            chunk, compressed_chunk, results
+        ):
+            point_count = len(points)
+            # Update the progress bar, if necessary
+            if progress is not None:
+                progress.update()
+            # Call competed_callback if provided
+            if completed_callback:
+                completed_callback(
+                    node=node,
+                    point_count=point_count,
+                    compressed_points=compressed_points,
+                    **return_vals,
+                )
+
+            if point_count > 0:
+                # Write the node out
+                if isinstance(writer, copc.FileWriter):
+                    writer.AddNodeCompressed(
+                        node.key,
+                        compressed_points,
+                        point_count,
+                        node.page_key,
+                    )
+                elif isinstance(writer, copc.LazWriter):
+                    writer.WritePointsCompressed(compressed_points, point_count)
+
+    # Update the LAS header with the global min/max, which are zeros if no points were written
+    if update_minmax:
+        extents.ApplyBounds(writer_header)
+
+
+def _transform_node(
+    transform_function,
+    transform_function_args,
+    node,
+    points,
+    reader,
+    writer_header,
+):
+    """Helper function that calls transform_function on a node's points."""
     # Actually call the transform_function
     ret = transform_function(
         points=points,
@@ -209,14 +187,4 @@ def _transform_node(
         points = ret
         return_vals = {}
 
-    # compute the minimum and maximum of the node's points, if necessary
-    xyz_min = None
-    xyz_max = None
-    if update_minmax and len(points) > 0:
-        xyz_min = [min(points.x), min(points.y), min(points.z)]
-        xyz_max = [max(points.x), max(points.y), max(points.z)]
-
-    point_count = len(points)
-    # Repack and compress the points using the new writer header
-    compressed_points = copc.CompressBytes(points.Pack(writer_header), writer_header)
-    return compressed_points, node, point_count, xyz_min, xyz_max, return_vals
+    return points, return_vals
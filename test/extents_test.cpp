@@ -3,8 +3,10 @@
 
 #include <catch2/catch.hpp>
 #include <copc-lib/copc/extents.hpp>
+#include <copc-lib/copc/extents_accumulator.hpp>
 #include <copc-lib/io/copc_reader.hpp>
 #include <copc-lib/io/copc_writer.hpp>
+#include <copc-lib/las/points.hpp>
 #include <copc-lib/las/vlr.hpp>
 
 using namespace copc;
@@ -223,3 +225,102 @@ TEST_CASE("COPC Extents", "[CopcExtents]")
     }
     // TODO[Leo]: Add all Extents functions to tests
 }
+
+TEST_CASE("Extents Accumulator", "[CopcExtents]")
+{
+    // Points with x = 0, 1, ..., 99
+    las::Points points(7);
+    for (int i = 0; i < 100; i++)
+    {
+        auto point = points.CreatePoint();
+        point->X(i);
+        point->Y(-i);
+        point->Z(i % 10);
+        point->Intensity(i * 2);
+        point->ReturnNumber(i % 4 + 1);
+        point->NumberOfReturns(4);
+        point->ScanAngle(i - 50);
+        points.AddPoint(point);
+    }
+    las::PointBuffer buffer(points);
+
+    SECTION("Add")
+    {
+        ExtentsAccumulator accumulator;
+        REQUIRE(accumulator.PointCount() == 0);
+        REQUIRE(!accumulator.HasField(FIELD_X));
+        REQUIRE_THROWS(accumulator.Extent(FIELD_X));
+
+        accumulator.Add(buffer);
+        REQUIRE(accumulator.PointCount() == 100);
+        auto x = accumulator.Extent(FIELD_X);
+        REQUIRE(x.minimum == 0);
+        REQUIRE(x.maximum == 99);
+        REQUIRE(x.mean == Approx(49.5));
+        // Population variance of 0..n-1 is (n^2 - 1) / 12
+        REQUIRE(x.var == Approx((100.0 * 100.0 - 1) / 12));
+        REQUIRE(accumulator.Extent(FIELD_Y).minimum == -99);
+        REQUIRE(accumulator.Extent(FIELD_INTENSITY).maximum == 198);
+        REQUIRE(accumulator.Extent(FIELD_RETURN_NUMBER).minimum == 1);
+        REQUIRE(accumulator.Extent(FIELD_RETURN_NUMBER).maximum == 4);
+        REQUIRE(accumulator.Extent(FIELD_NUMBER_OF_RETURNS).var == 0);
+        // Format 7 has RGB but no NIR
+        REQUIRE(accumulator.HasField(FIELD_RED));
+        REQUIRE(!accumulator.HasField(FIELD_NIR));
+    }
+
+    SECTION("Merge")
+    {
+        ExtentsAccumulator all;
+        all.Add(buffer);
+
+        // Splitting the points gives the same result, in any order
+        ExtentsAccumulator first, second;
+        for (size_t i = 0; i < buffer.Size(); i++)
+        {
+            std::vector<uint8_t> mask(buffer.Size(), 0);
+            mask[i] = 1;
+            (i % 3 == 0 ? first : second).Add(buffer.GetSubset(mask));
+        }
+        second.Merge(first);
+        REQUIRE(second.PointCount() == 100);
+        for (auto field : {FIELD_X, FIELD_Z, FIELD_INTENSITY, FIELD_SCAN_ANGLE})
+        {
+            REQUIRE(second.Extent(field).minimum == all.Extent(field).minimum);
+            REQUIRE(second.Extent(field).maximum == all.Extent(field).maximum);
+            REQUIRE(second.Extent(field).mean == Approx(all.Extent(field).mean));
+            REQUIRE(second.Extent(field).var == Approx(all.Extent(field).var));
+        }
+
+        ExtentsAccumulator empty;
+        empty.Merge(all);
+        REQUIRE(empty.ToString() == all.ToString());
+        all.Merge(ExtentsAccumulator());
+        REQUIRE(empty.ToString() == all.ToString());
+    }
+
+    SECTION("Apply")
+    {
+        ExtentsAccumulator accumulator;
+        accumulator.Add(buffer);
+
+        CopcExtents extents(7, 1, true);
+        extents.ExtraBytes()[0]->maximum = 5;
+        accumulator.Apply(extents);
+        REQUIRE(*extents.X() == accumulator.Extent(FIELD_X));
+        REQUIRE(*extents.Blue() == accumulator.Extent(FIELD_BLUE));
+        // The scan angle is converted to degrees
+        REQUIRE(extents.ScanAngle()->minimum == Approx(-50 * 0.006));
+        REQUIRE(extents.ScanAngle()->maximum == Approx(49 * 0.006));
+        // Extra bytes are left as they are
+        REQUIRE(extents.ExtraBytes()[0]->maximum == 5);
+
+        las::LasHeader header;
+        accumulator.ApplyBounds(header);
+        REQUIRE(header.min == Vector3(0, -99, 0));
+        REQUIRE(header.max == Vector3(99, 0, 9));
+        ExtentsAccumulator().ApplyBounds(header);
+        REQUIRE(header.min == Vector3());
+        REQUIRE(header.max == Vector3());
+    }
+}
@@ -154,3 +154,52 @@ def test_copc_extents():
     for extent in extents.extents:
         assert extent.minimum == 1
         assert extent.maximum == 1
+
+
+def test_extents_accumulator():
+    points = copc.Points(7)
+    for i in range(100):
+        point = points.CreatePoint()
+        point.x = i
+        point.y = -i
+        point.z = i % 10
+        point.intensity = i * 2
+        points.AddPoint(point)
+    buffer = copc.PointBuffer(points)
+
+    accumulator = copc.ExtentsAccumulator()
+    assert accumulator.point_count == 0
+    accumulator.Add(buffer)
+    assert accumulator.point_count == 100
+    x = accumulator.Extent(copc.PointField.X)
+    assert x.minimum == 0
+    assert x.maximum == 99
+    assert x.mean == pytest.approx(49.5)
+    assert x.var == pytest.approx((100 * 100 - 1) / 12)
+
+    # Merging gives the same result as adding all the points at once
+    merged = copc.ExtentsAccumulator()
+    merged.Add(buffer)
+    merged.Merge(accumulator)
+    assert merged.point_count == 200
+    assert merged.Extent(copc.PointField.INTENSITY).mean == pytest.approx(99)
+    assert merged.Extent(copc.PointField.X).var == pytest.approx(x.var)
+
+    extents = copc.CopcExtents(7)
+    accumulator.Apply(extents)
+    assert extents.intensity.maximum == 198
+    assert extents.x.mean == pytest.approx(49.5)
+
+    header = copc.LazConfigWriter(7).las_header
+    accumulator.ApplyBounds(header)
+    assert header.max.x == 99
+    assert header.min.y == -99
+
+
+    # The batch compressor accumulates the points as it packs them
+    compressed_extents = copc.ExtentsAccumulator()
+    compressed = copc.CompressPoints([points, points], header, 2, compressed_extents)
+    assert len(compressed) == 2
+    assert compressed_extents.point_count == 200
+    assert compressed_extents.Extent(copc.PointField.X).maximum == pytest.approx(99)
+    assert compressed_extents.Extent(copc.PointField.Y).minimum == pytest.approx(-99)
@@ -2,6 +2,7 @@
 #include <sstream>
 
 #include "catch2/catch.hpp"
+#include <copc-lib/hierarchy/internal/node_index.hpp>
 #include <copc-lib/io/copc_reader.hpp>
 
 using namespace copc;
@@ -36,3 +37,90 @@ TEST_CASE("Packing Test", "[Hierarchy] ")
         REQUIRE(point_data_read == point_data_write);
     }
 }
+
+TEST_CASE("Entry Unpacking Test", "[Hierarchy] ")
+{
+    std::vector<Entry> entries{Entry(VoxelKey(0, 0, 0, 0), 1000, 200, 50),
+                               Entry(VoxelKey(1, 1, 0, 1), 1ull << 40, 32, -1),
+                               Entry(VoxelKey(3, 7, 2, 5), 5000, 0, 0)};
+    ostringstream oss;
+    for (auto &e : entries)
+        e.Pack(oss);
+    string data = oss.str();
+    REQUIRE(data.size() == entries.size() * Entry::ENTRY_SIZE);
+
+    SECTION("Matches single entry unpacking")
+    {
+        auto unpacked = Entry::UnpackEntries(data.data(), data.size());
+        REQUIRE(unpacked.size() == entries.size());
+        for (size_t i = 0; i < entries.size(); i++)
+        {
+            auto single = Entry::Unpack(data.data() + i * Entry::ENTRY_SIZE);
+            REQUIRE(unpacked[i].key == entries[i].key);
+            REQUIRE(unpacked[i].offset == entries[i].offset);
+            REQUIRE(unpacked[i].byte_size == entries[i].byte_size);
+            REQUIRE(unpacked[i].point_count == entries[i].point_count);
+            REQUIRE(unpacked[i].key == single.key);
+            REQUIRE(unpacked[i].offset == single.offset);
+        }
+        REQUIRE(unpacked[1].IsPage());
+        REQUIRE(Entry::UnpackEntries(data.data(), 0).empty());
+    }
+
+    SECTION("Invalid pages")
+    {
+        REQUIRE_THROWS(Entry::UnpackEntries(data.data(), data.size() - 1));
+
+        ostringstream invalid;
+        Entry(VoxelKey(2, -1, 0, 0), 1000, 200, 50).Pack(invalid);
+        string invalid_data = data + invalid.str();
+        REQUIRE_THROWS(Entry::UnpackEntries(invalid_data.data(), invalid_data.size()));
+
+        ostringstream invalid_size;
+        Entry(VoxelKey(2, 1, 0, 0), 1000, -5, 50).Pack(invalid_size);
+        invalid_data = data + invalid_size.str();
+        REQUIRE_THROWS(Entry::UnpackEntries(invalid_data.data(), invalid_data.size()));
+    }
+}
+
+TEST_CASE("NodeIndex Test", "[Hierarchy] ")
+{
+    Internal::NodeIndex index;
+    std::vector<Entry> root_entries{Entry(VoxelKey(1, 1, 1, 1), 300, 30, 3), Entry(VoxelKey(0, 0, 0, 0), 100, 10, 1),
+                                    Entry(VoxelKey(1, 0, 0, 0), 500, 32, -1)};
+    index.AddPage(VoxelKey::RootKey(), root_entries);
+    // The subpage entry isn't a node
+    REQUIRE(index.Size() == 2);
+
+    Node node;
+    REQUIRE(index.Find(VoxelKey(1, 1, 1, 1), node));
+    REQUIRE(node.offset == 300);
+    REQUIRE(node.byte_size == 30);
+    REQUIRE(node.point_count == 3);
+    REQUIRE(node.page_key == VoxelKey::RootKey());
+    REQUIRE_FALSE(index.Find(VoxelKey(1, 0, 0, 0), node));
+    REQUIRE_FALSE(index.Contains(VoxelKey(5, 0, 0, 0)));
+
+    // Pages added after a lookup are merged into the sorted order
+    std::vector<Entry> sub_entries{Entry(VoxelKey(2, 1, 0, 0), 700, 70, 7), Entry(VoxelKey(1, 0, 0, 0), 600, 60, 6),
+                                   Entry(VoxelKey(2, 0, 1, 0), 800, 80, 8)};
+    index.AddPage(VoxelKey(1, 0, 0, 0), sub_entries);
+    REQUIRE(index.Size() == 5);
+    for (const auto &e : root_entries)
+        REQUIRE(index.Contains(e.key) == !e.IsPage());
+    for (const auto &e : sub_entries)
+    {
+        REQUIRE(index.Find(e.key, node));
+        REQUIRE(node.offset == e.offset);
+        REQUIRE(node.page_key == VoxelKey(1, 0, 0, 0));
+    }
+
+    std::vector<Node> page_nodes;
+    index.AppendPageNodes(VoxelKey(1, 0, 0, 0), page_nodes);
+    REQUIRE(page_nodes.size() == 3);
+    REQUIRE(page_nodes[0].key == VoxelKey(2, 1, 0, 0));
+    index.AppendPageNodes(VoxelKey::RootKey(), page_nodes);
+    REQUIRE(page_nodes.size() == 5);
+    index.AppendPageNodes(VoxelKey(4, 0, 0, 0), page_nodes);
+    REQUIRE(page_nodes.size() == 5);
+}
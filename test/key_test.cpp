@@ -1,9 +1,13 @@
+#include <algorithm>
 #include <limits>
+#include <unordered_set>
+#include <vector>
 
 #include <catch2/catch.hpp>
 #include <copc-lib/geometry/box.hpp>
 #include <copc-lib/geometry/vector3.hpp>
 #include <copc-lib/hierarchy/key.hpp>
+#include <copc-lib/hierarchy/morton_key.hpp>
 #include <copc-lib/las/header.hpp>
 
 using namespace copc;
@@ -84,6 +88,131 @@ TEST_CASE("IsChild Checks", "[Key]")
 
     REQUIRE(!VoxelKey(4, 4, 6, 12).ChildOf(VoxelKey(3, 4, 8, 6)));
     REQUIRE(!VoxelKey(3, 2, 3, 6).ChildOf(VoxelKey(2, 2, 2, 2)));
+
+    REQUIRE(VoxelKey(3, 2, 3, 6).ChildOf(VoxelKey(3, 2, 3, 6)));
+    REQUIRE(!VoxelKey(2, 1, 1, 3).ChildOf(VoxelKey(3, 2, 3, 6)));
+    REQUIRE(VoxelKey(40, 5, 6, 7).ChildOf(VoxelKey::RootKey()));
+    REQUIRE(!VoxelKey(40, 5, 6, 7).ChildOf(VoxelKey(1, 1, 0, 0)));
+}
+
+TEST_CASE("MortonKey Checks", "[Key]")
+{
+    SECTION("Round trip")
+    {
+        REQUIRE(MortonKey::RootKey().Code() == 1);
+        REQUIRE(MortonKey::RootKey().ToVoxelKey() == VoxelKey::RootKey());
+        REQUIRE(!MortonKey().IsValid());
+        REQUIRE(!MortonKey().ToVoxelKey().IsValid());
+
+        for (const auto &key : {VoxelKey(1, 1, 0, 1), VoxelKey(4, 4, 6, 12), VoxelKey(10, 1023, 0, 511),
+                                VoxelKey(MortonKey::MAX_DEPTH, (1 << 21) - 1, 12345, (1 << 21) - 1)})
+        {
+            MortonKey morton(key);
+            REQUIRE(morton.IsValid());
+            REQUIRE(morton.Depth() == key.d);
+            REQUIRE(morton.ToVoxelKey() == key);
+            REQUIRE(MortonKey::FromCode(morton.Code()) == morton);
+        }
+
+        REQUIRE(!MortonKey::Representable(VoxelKey::InvalidKey()));
+        REQUIRE(!MortonKey::Representable(VoxelKey(22, 0, 0, 0)));
+        REQUIRE(!MortonKey::Representable(VoxelKey(2, 4, 0, 0)));
+        REQUIRE_THROWS(MortonKey(VoxelKey(22, 0, 0, 0)));
+        REQUIRE_THROWS(MortonKey(VoxelKey(2, 0, 0, 4)));
+        REQUIRE_THROWS(MortonKey::FromCode(0));
+        REQUIRE_THROWS(MortonKey::FromCode(2));
+    }
+
+    SECTION("Parent and children")
+    {
+        VoxelKey key(4, 4, 6, 12);
+        MortonKey morton(key);
+        REQUIRE(morton.Parent().ToVoxelKey() == key.GetParent());
+        REQUIRE(morton.ParentAtDepth(1).ToVoxelKey() == key.GetParentAtDepth(1));
+        REQUIRE(morton.ParentAtDepth(4) == morton);
+        REQUIRE_THROWS(morton.ParentAtDepth(5));
+        REQUIRE(!MortonKey::RootKey().Parent().IsValid());
+
+        auto children = morton.Children();
+        REQUIRE(children.size() == 8);
+        for (int i = 0; i < 8; i++)
+        {
+            REQUIRE(children[i].ToVoxelKey() == key.Bisect(i));
+            REQUIRE(children[i].Direction() == i);
+            REQUIRE(children[i].Parent() == morton);
+        }
+        REQUIRE_THROWS(MortonKey(VoxelKey(MortonKey::MAX_DEPTH, 0, 0, 0)).Children());
+    }
+
+    SECTION("Siblings")
+    {
+        REQUIRE(MortonKey::RootKey().Siblings().empty());
+
+        MortonKey morton(VoxelKey(3, 2, 3, 6));
+        auto siblings = morton.Siblings();
+        REQUIRE(siblings.size() == 7);
+        for (const auto &sibling : siblings)
+        {
+            REQUIRE(sibling != morton);
+            REQUIRE(sibling.Parent() == morton.Parent());
+        }
+    }
+
+    SECTION("ChildOf")
+    {
+        std::vector<VoxelKey> keys = {VoxelKey::RootKey(), VoxelKey(1, 1, 1, 1), VoxelKey(2, 1, 1, 3),
+                                      VoxelKey(2, 2, 2, 2), VoxelKey(3, 2, 3, 6), VoxelKey(3, 4, 8, 6),
+                                      VoxelKey(4, 4, 6, 12)};
+        for (const auto &a : keys)
+        {
+            if (!MortonKey::Representable(a))
+                continue;
+            for (const auto &b : keys)
+            {
+                if (MortonKey::Representable(b))
+                    REQUIRE(MortonKey(a).ChildOf(MortonKey(b)) == a.ChildOf(b));
+            }
+        }
+        REQUIRE(!MortonKey::RootKey().ChildOf(MortonKey()));
+    }
+
+    SECTION("Descendants are contiguous in pre-order")
+    {
+        std::vector<MortonKey> keys;
+        for (const auto &child : MortonKey::RootKey().Children())
+        {
+            keys.push_back(child);
+            for (const auto &grandchild : child.Children())
+                keys.push_back(grandchild);
+        }
+        keys.push_back(MortonKey::RootKey());
+        std::reverse(keys.begin(), keys.end());
+        std::sort(keys.begin(), keys.end());
+
+        REQUIRE(keys.front() == MortonKey::RootKey());
+        for (const auto &key : keys)
+        {
+            auto range = key.DescendantRange();
+            auto begin = std::find(keys.begin(), keys.end(), key);
+            auto end = std::find_if(begin + 1, keys.end(), [&](const MortonKey &k) { return !k.ChildOf(key); });
+            for (auto it = begin; it != end; it++)
+            {
+                REQUIRE(it->PreorderPosition() >= range.first);
+                REQUIRE(it->PreorderPosition() < range.second);
+            }
+            REQUIRE(std::count_if(keys.begin(), keys.end(), [&](const MortonKey &k) { return k.ChildOf(key); }) ==
+                    end - begin);
+        }
+    }
+
+    SECTION("Hash")
+    {
+        std::unordered_set<MortonKey> set;
+        for (const auto &child : MortonKey::RootKey().Children())
+            set.insert(child);
+        REQUIRE(set.size() == 8);
+        REQUIRE(set.count(MortonKey(VoxelKey(1, 1, 0, 1))) == 1);
+    }
 }
 
 TEST_CASE("GetParents Checks", "[Key]")
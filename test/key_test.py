@@ -80,6 +80,33 @@ def test_is_child():
     assert not copc.VoxelKey(3, 2, 3, 6).ChildOf((2, 2, 2, 2))
 
 
+def test_morton_key():
+    key = copc.VoxelKey(4, 4, 6, 12)
+    morton = copc.MortonKey(key)
+    assert morton.depth == 4
+    assert morton.ToVoxelKey() == key
+    assert copc.MortonKey.FromCode(morton.code) == morton
+    assert copc.MortonKey.RootKey().code == 1
+
+    assert morton.Parent().ToVoxelKey() == key.GetParent()
+    children = morton.Children()
+    assert len(children) == 8
+    for i, child in enumerate(children):
+        assert child.ToVoxelKey() == key.Bisect(i)
+        assert child.ChildOf(morton)
+    assert len(morton.Siblings()) == 7
+    assert len(copc.MortonKey.RootKey().Siblings()) == 0
+
+    begin, end = morton.DescendantRange()
+    assert begin <= children[7].PreorderPosition() < end
+    assert sorted(children + [morton])[0] == morton
+    assert len({morton, copc.MortonKey(key)}) == 1
+
+    assert not copc.MortonKey.Representable(copc.VoxelKey(22, 0, 0, 0))
+    with pytest.raises(RuntimeError):
+        copc.MortonKey(copc.VoxelKey(2, 4, 0, 0))
+
+
 def test_get_parents():
     assert len(copc.VoxelKey(-1, -1, -1, -1).GetParents(True)) == 0
     assert len(copc.VoxelKey(-1, -1, -1, -1).GetParents(False)) == 0
@@ -5,6 +5,7 @@
 #include <copc-lib/geometry/vector3.hpp>
 #include <copc-lib/io/laz_reader.hpp>
 #include <copc-lib/io/laz_writer.hpp>
+#include <copc-lib/laz/compressor.hpp>
 
 using namespace copc;
 using namespace std;
@@ -256,3 +257,44 @@ TEST_CASE("LAZ Write Points", "[LAZ Writer]")
     REQUIRE(read_points.Get(3)->Y() == 12);
     REQUIRE(read_points.Get(3)->Z() == 13);
 }
+
+TEST_CASE("LAZ Writer Auto Extents", "[LAZ Writer]")
+{
+    string file_path = "writer_auto_extents_test.laz";
+
+    las::LazConfigWriter cfg(6);
+    // Bounds set by the caller are replaced by the ones of the points
+    cfg.LasHeader()->min = Vector3(-100, -100, -100);
+    cfg.LasHeader()->max = Vector3(100, 100, 100);
+    laz::LazFileWriter writer(file_path, cfg);
+    writer.EnableAutoExtents();
+
+    las::Points points(*cfg.LasHeader());
+    for (int i = 0; i < 10; i++)
+    {
+        auto point = points.CreatePoint();
+        point->X(i);
+        point->Y(i + 10);
+        point->Z(-i);
+        points.AddPoint(point);
+    }
+    writer.WritePoints(points);
+
+    // Compressed points count too
+    las::Points more_points(*cfg.LasHeader());
+    auto point = more_points.CreatePoint();
+    point->X(20);
+    point->Y(5);
+    point->Z(3);
+    more_points.AddPoint(point);
+    writer.WritePointsCompressed(laz::Compressor::CompressPoints(more_points, *cfg.LasHeader()), 1);
+
+    auto extents = writer.AccumulatedExtents();
+    REQUIRE(extents.PointCount() == 11);
+    REQUIRE(extents.Extent(FIELD_X).maximum == 20);
+    writer.Close();
+
+    laz::LazFileReader reader(file_path);
+    REQUIRE(reader.LazConfig().LasHeader().min == Vector3(0, 5, -9));
+    REQUIRE(reader.LazConfig().LasHeader().max == Vector3(20, 19, 3));
+}
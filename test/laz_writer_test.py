@@ -226,3 +226,28 @@ def test_write():
     assert read_points.x == [0, 11, 0, 11]
     assert read_points.y == [0, 12, 0, 12]
     assert read_points.z == [0, 13, 0, 13]
+
+
+def test_write_auto_extents():
+    file_path = os.path.join(get_data_dir(), "writer_auto_extents_test.laz")
+
+    cfg = copc.LazConfigWriter(6)
+    writer = copc.LazWriter(file_path, cfg)
+    writer.EnableAutoExtents()
+
+    points = copc.Points(cfg.las_header)
+    for i in range(10):
+        point = points.CreatePoint()
+        point.x = i
+        point.y = i + 10
+        point.z = -i
+        points.AddPoint(point)
+    writer.WritePoints(points)
+    assert writer.AccumulatedExtents().point_count == 10
+    writer.Close()
+
+    reader = copc.LazReader(file_path)
+    header = reader.laz_config.las_header
+    assert (header.min.x, header.min.y, header.min.z) == (0, 10, -9)
+    assert (header.max.x, header.max.y, header.max.z) == (9, 19, 0)
+
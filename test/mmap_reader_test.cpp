@@ -0,0 +1,99 @@
+#include <catch2/catch.hpp>
+#include <copc-lib/io/copc_mmap_reader.hpp>
+#include <copc-lib/io/copc_reader.hpp>
+#include <copc-lib/io/copc_writer.hpp>
+
+using namespace copc;
+using namespace std;
+
+TEST_CASE("MmapReader tests", "[MmapReader]")
+{
+    GIVEN("A written file")
+    {
+        std::string file_path = "mmap_reader_test.copc.laz";
+
+        auto make_points = [](int count, double start)
+        {
+            las::Points points(7);
+            for (int i = 0; i < count; i++)
+            {
+                auto point = points.CreatePoint();
+                point->X(start + i);
+                point->Y(start + 2 * i);
+                point->Z(start + 3 * i);
+                point->Intensity(static_cast<uint16_t>(i));
+                points.AddPoint(point);
+            }
+            return points;
+        };
+
+        {
+            FileWriter writer(file_path, CopcConfigWriter(7));
+            writer.AddNode(VoxelKey::RootKey(), make_points(20, 0));
+            writer.AddNode(VoxelKey(1, 1, 1, 1), make_points(12, 10), VoxelKey(1, 1, 1, 1));
+            writer.AddNode(VoxelKey(2, 2, 2, 2), make_points(60, 20), VoxelKey(1, 1, 1, 1));
+            writer.Close();
+        }
+
+        MmapReader reader(file_path);
+        FileReader file_reader(file_path);
+
+        SECTION("Header")
+        {
+            REQUIRE(reader.FileSize() > 0);
+            REQUIRE(reader.FilePath() == file_path);
+            REQUIRE(reader.CopcConfig().LasHeader().PointFormatId() == 7);
+            REQUIRE(reader.CopcConfig().LasHeader().PointCount() == file_reader.CopcConfig().LasHeader().PointCount());
+            REQUIRE(reader.CopcConfig().CopcInfo().root_hier_offset ==
+                    file_reader.CopcConfig().CopcInfo().root_hier_offset);
+        }
+
+        SECTION("Hierarchy")
+        {
+            REQUIRE(reader.GetAllNodes().size() == 3);
+            REQUIRE(reader.GetPageList().size() == 2);
+            auto node = reader.FindNode(VoxelKey(2, 2, 2, 2));
+            auto file_node = file_reader.FindNode(VoxelKey(2, 2, 2, 2));
+            REQUIRE(node.offset == file_node.offset);
+            REQUIRE(node.byte_size == file_node.byte_size);
+            REQUIRE(node.point_count == file_node.point_count);
+            REQUIRE(node.page_key == file_node.page_key);
+            REQUIRE(!reader.FindNode(VoxelKey(5, 4, 3, 2)).IsValid());
+        }
+
+        SECTION("Point data")
+        {
+            REQUIRE(reader.GetPointData(VoxelKey::RootKey()) == file_reader.GetPointData(VoxelKey::RootKey()));
+            REQUIRE(reader.GetPoints(VoxelKey(1, 1, 1, 1)).Size() == 12);
+            REQUIRE(reader.GetPoints(VoxelKey(2, 2, 2, 2)).Z() == make_points(60, 20).Z());
+            REQUIRE(reader.GetPointData(VoxelKey(5, 4, 3, 2)).empty());
+
+            for (const auto &node : file_reader.GetAllNodes())
+            {
+                REQUIRE(reader.GetPointDataCompressed(node) == file_reader.GetPointDataCompressed(node));
+                REQUIRE(reader.GetPointData(node) == file_reader.GetPointData(node));
+            }
+        }
+
+        SECTION("Invalid node")
+        {
+            REQUIRE_THROWS(reader.GetPointData(Node()));
+            REQUIRE_THROWS(reader.GetPointDataCompressed(Node()));
+
+            Node out_of_range(Entry(VoxelKey(1, 0, 0, 0), reader.FileSize() - 10, 100, 1), VoxelKey::RootKey());
+            REQUIRE_THROWS(reader.GetPointData(out_of_range));
+            REQUIRE_THROWS(reader.GetPointDataCompressed(out_of_range));
+        }
+
+        SECTION("Close")
+        {
+            reader.Close();
+            REQUIRE_THROWS(reader.GetPointDataCompressed(file_reader.FindNode(VoxelKey::RootKey())));
+        }
+    }
+
+    GIVEN("An invalid file path")
+    {
+        REQUIRE_THROWS(MmapReader("invalid_path/mmap_reader_test.copc.laz"));
+    }
+}
@@ -0,0 +1,34 @@
+import copclib as copc
+import pytest
+
+from .utils import generate_test_file
+
+
+def test_mmap_reader():
+    file_path = generate_test_file()
+
+    # Given an invalid file path
+    with pytest.raises(RuntimeError):
+        assert copc.MmapReader("invalid_path/non_existant_file.copc.laz")
+
+    reader = copc.MmapReader(file_path)
+    file_reader = copc.FileReader(file_path)
+
+    assert isinstance(reader, copc.Reader)
+    assert isinstance(file_reader, copc.Reader)
+    assert reader.path == file_path
+    assert reader.file_size > 0
+    assert (
+        reader.copc_config.las_header.point_count
+        == file_reader.copc_config.las_header.point_count
+    )
+
+    nodes = file_reader.GetAllNodes()
+    assert len(reader.GetAllNodes()) == len(nodes)
+    for node in nodes:
+        assert reader.GetPointDataCompressed(node) == file_reader.GetPointDataCompressed(
+            node
+        )
+        assert reader.GetPointData(node.key) == file_reader.GetPointData(node)
+
+    reader.Close()
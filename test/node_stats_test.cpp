@@ -0,0 +1,166 @@
+#include <sstream>
+#include <unordered_map>
+#include <vector>
+
+#include <catch2/catch.hpp>
+#include <copc-lib/copc/node_stats.hpp>
+#include <copc-lib/copc/point_filter.hpp>
+#include <copc-lib/las/point_buffer.hpp>
+#include <copc-lib/las/points.hpp>
+
+using namespace copc;
+using namespace std;
+
+namespace
+{
+las::PointBuffer MakeBuffer(int8_t point_format_id, int count)
+{
+    las::Points points(point_format_id);
+    for (int i = 0; i < count; i++)
+    {
+        auto point = points.CreatePoint();
+        point->X(i * 1.5);
+        point->Y(i * -2.25);
+        point->Z(i * 0.5);
+        point->Intensity(i);
+        point->ReturnNumber(i % 4 + 1);
+        point->NumberOfReturns(4);
+        point->EdgeOfFlightLineFlag(i % 10 == 0);
+        point->Classification(i % 3 == 0 ? 2 : 6);
+        point->GPSTime(i * 10.0);
+        if (point->HasRgb())
+            point->Rgb(i, i + 1, i + 2);
+        points.AddPoint(point);
+    }
+    return las::PointBuffer(points);
+}
+} // namespace
+
+TEST_CASE("NodeStats", "[NodeStats]")
+{
+    SECTION("FromPoints")
+    {
+        auto stats = NodeStats::FromPoints(MakeBuffer(6, 30));
+        REQUIRE(stats.PointCount() == 30);
+        REQUIRE(stats.Minimum(FIELD_X) == 0);
+        REQUIRE(stats.Maximum(FIELD_X) == 29 * 1.5);
+        REQUIRE(stats.Minimum(FIELD_Y) == 29 * -2.25);
+        REQUIRE(stats.Maximum(FIELD_INTENSITY) == 29);
+        REQUIRE(stats.Minimum(FIELD_RETURN_NUMBER) == 1);
+        REQUIRE(stats.Maximum(FIELD_RETURN_NUMBER) == 4);
+        REQUIRE(stats.Minimum(FIELD_NUMBER_OF_RETURNS) == 4);
+        REQUIRE(stats.Maximum(FIELD_EDGE_OF_FLIGHT_LINE) == 1);
+        REQUIRE(stats.Maximum(FIELD_GPS_TIME) == 290);
+        REQUIRE(stats.ClassificationCount(2) == 10);
+        REQUIRE(stats.ClassificationCount(6) == 20);
+        REQUIRE(stats.ClassificationCount(1) == 0);
+        REQUIRE(stats.ClassificationCounts().size() == 2);
+
+        // Format 6 has no RGB
+        REQUIRE(!stats.HasField(FIELD_RED));
+        REQUIRE_THROWS(stats.Minimum(FIELD_RED));
+        REQUIRE(NodeStats::FromPoints(MakeBuffer(7, 30)).Maximum(FIELD_BLUE) == 31);
+
+        // Only the dimensions the buffer holds have stats
+        auto buffer = MakeBuffer(6, 30);
+        auto partial = las::PointBuffer::Unpack(buffer.Pack(Vector3::DefaultScale(), Vector3::DefaultOffset()), 6, 0,
+                                                Vector3::DefaultScale(), Vector3::DefaultOffset(),
+                                                las::Dimension::DIM_CLASSIFICATION);
+        stats = NodeStats::FromPoints(partial);
+        REQUIRE(stats.HasField(FIELD_CLASSIFICATION));
+        REQUIRE(!stats.HasField(FIELD_X));
+
+        stats = NodeStats::FromPoints(MakeBuffer(6, 0));
+        REQUIRE(stats.PointCount() == 0);
+        REQUIRE(!stats.HasField(FIELD_X));
+    }
+
+    SECTION("Merge")
+    {
+        auto stats = NodeStats::FromPoints(MakeBuffer(6, 10));
+        auto other = NodeStats::FromPoints(MakeBuffer(7, 30));
+        stats.Merge(other);
+        REQUIRE(stats.PointCount() == 40);
+        REQUIRE(stats.Maximum(FIELD_X) == 29 * 1.5);
+        REQUIRE(stats.ClassificationCount(2) == 14);
+        REQUIRE(stats.ClassificationCount(6) == 26);
+        // Only the fields both sides have are kept
+        REQUIRE(!stats.HasField(FIELD_RED));
+
+        NodeStats empty;
+        empty.Merge(other);
+        REQUIRE(empty.ToString() == other.ToString());
+    }
+
+    SECTION("Pack/Unpack")
+    {
+        auto stats = NodeStats::FromPoints(MakeBuffer(7, 30));
+        stringstream ss;
+        stats.Pack(ss);
+        auto unpacked = NodeStats::Unpack(ss);
+        REQUIRE(unpacked.ToString() == stats.ToString());
+        REQUIRE(unpacked.Maximum(FIELD_BLUE) == 31);
+
+        unordered_map<VoxelKey, NodeStats> nodes{{VoxelKey::RootKey(), stats}, {VoxelKey(1, 1, 0, 1), NodeStats()}};
+        auto data = NodeStats::PackNodes(nodes);
+        auto unpacked_nodes = NodeStats::UnpackNodes(data);
+        REQUIRE(unpacked_nodes.size() == 2);
+        REQUIRE(unpacked_nodes.at(VoxelKey::RootKey()).ToString() == stats.ToString());
+        REQUIRE(unpacked_nodes.at(VoxelKey(1, 1, 0, 1)).PointCount() == 0);
+
+        data.pop_back();
+        REQUIRE_THROWS(NodeStats::UnpackNodes(data));
+    }
+}
+
+TEST_CASE("PointFilter", "[PointFilter]")
+{
+    auto buffer = MakeBuffer(7, 30);
+
+    SECTION("Mask and Apply")
+    {
+        REQUIRE(PointFilter().Empty());
+        REQUIRE(PointFilter().Apply(buffer).Size() == 30);
+
+        auto filter = PointFilter().In(FIELD_CLASSIFICATION, {2}).Range(FIELD_GPS_TIME, 50, 200);
+        REQUIRE(filter.RequiredDimensions() ==
+                static_cast<uint32_t>(las::Dimension::DIM_CLASSIFICATION | las::Dimension::DIM_GPS_TIME));
+
+        auto mask = filter.Mask(buffer);
+        for (size_t i = 0; i < buffer.Size(); i++)
+            REQUIRE(mask[i] == (i % 3 == 0 && i >= 5 && i <= 20));
+
+        auto filtered = filter.Apply(buffer);
+        REQUIRE(filtered.Size() == 5);
+        REQUIRE(filtered.GPSTime() == vector<double>{60, 90, 120, 150, 180});
+        REQUIRE(filtered.X()[0] == 6 * 1.5);
+
+        // Bit fields
+        REQUIRE(PointFilter().In(FIELD_EDGE_OF_FLIGHT_LINE, {1}).Apply(buffer).Size() == 3);
+        REQUIRE(PointFilter().Range(FIELD_RETURN_NUMBER, 2, 3).Apply(buffer).Size() == 15);
+        REQUIRE(PointFilter().In(FIELD_INTENSITY, {1, 2, 100}).Apply(buffer).Size() == 2);
+        REQUIRE(PointFilter().In(FIELD_CLASSIFICATION, {}).Apply(buffer).Size() == 0);
+
+        REQUIRE_THROWS(PointFilter().Range(FIELD_X, 1, 0));
+        // Format 6 has no RGB
+        REQUIRE_THROWS(PointFilter().Range(FIELD_RED, 0, 1).Apply(MakeBuffer(6, 30)));
+    }
+
+    SECTION("MayMatch")
+    {
+        auto stats = NodeStats::FromPoints(buffer);
+        REQUIRE(PointFilter().MayMatch(stats));
+        REQUIRE(PointFilter().Range(FIELD_GPS_TIME, 100, 1000).MayMatch(stats));
+        REQUIRE(!PointFilter().Range(FIELD_GPS_TIME, 300, 1000).MayMatch(stats));
+        REQUIRE(PointFilter().In(FIELD_CLASSIFICATION, {1, 2}).MayMatch(stats));
+        // Classes between the min and max that the node doesn't have are ruled out by the histogram
+        REQUIRE(!PointFilter().In(FIELD_CLASSIFICATION, {3, 4, 5}).MayMatch(stats));
+        REQUIRE(!PointFilter().In(FIELD_INTENSITY, {30, 31}).MayMatch(stats));
+        REQUIRE(!PointFilter().In(FIELD_CLASSIFICATION, {2}).Range(FIELD_X, -10, -1).MayMatch(stats));
+
+        // Fields without stats can't rule a node out
+        auto no_rgb = NodeStats::FromPoints(MakeBuffer(6, 30));
+        REQUIRE(PointFilter().Range(FIELD_RED, 1000, 2000).MayMatch(no_rgb));
+        REQUIRE(!PointFilter().Range(FIELD_RED, 1000, 2000).MayMatch(stats));
+    }
+}
@@ -0,0 +1,68 @@
+import copclib as copc
+import pytest
+
+
+def make_buffer(point_format_id, count):
+    points = copc.Points(point_format_id)
+    for i in range(count):
+        point = points.CreatePoint()
+        point.x = i * 1.5
+        point.y = i * -2.25
+        point.z = i * 0.5
+        point.intensity = i
+        point.classification = 2 if i % 3 == 0 else 6
+        point.gps_time = i * 10.0
+        points.AddPoint(point)
+    return copc.PointBuffer(points)
+
+
+def test_node_stats():
+    stats = copc.NodeStats.FromPoints(make_buffer(6, 30))
+    assert stats.point_count == 30
+    assert stats.Minimum(copc.PointField.X) == 0
+    assert stats.Maximum(copc.PointField.X) == 29 * 1.5
+    assert stats.Maximum(copc.PointField.GPS_TIME) == 290
+    assert stats.ClassificationCount(2) == 10
+    assert stats.ClassificationCount(6) == 20
+    assert stats.classification_counts == [(2, 10), (6, 20)]
+
+    # Format 6 has no RGB
+    assert not stats.HasField(copc.PointField.RED)
+    with pytest.raises(RuntimeError):
+        stats.Minimum(copc.PointField.RED)
+
+    stats.Merge(copc.NodeStats.FromPoints(make_buffer(7, 30)))
+    assert stats.point_count == 60
+    assert stats.ClassificationCount(2) == 20
+    assert not stats.HasField(copc.PointField.RED)
+    assert str(stats)
+
+
+def test_point_filter():
+    buffer = make_buffer(7, 30)
+    stats = copc.NodeStats.FromPoints(buffer)
+
+    point_filter = (
+        copc.PointFilter()
+        .In(copc.PointField.CLASSIFICATION, [2])
+        .Range(copc.PointField.GPS_TIME, 50, 200)
+    )
+    assert not point_filter.Empty()
+    assert point_filter.required_dimensions == (
+        copc.Dimension.CLASSIFICATION | copc.Dimension.GPS_TIME
+    )
+
+    mask = point_filter.Mask(buffer)
+    assert mask == [int(i % 3 == 0 and 5 <= i <= 20) for i in range(30)]
+    filtered = point_filter.Apply(buffer)
+    assert filtered.gps_time == [60, 90, 120, 150, 180]
+    assert len(buffer.GetSubset(mask)) == 5
+
+    assert point_filter.MayMatch(stats)
+    assert not copc.PointFilter().Range(copc.PointField.GPS_TIME, 300, 400).MayMatch(
+        stats
+    )
+    assert not copc.PointFilter().In(copc.PointField.CLASSIFICATION, [3, 4]).MayMatch(
+        stats
+    )
+    assert str(point_filter)
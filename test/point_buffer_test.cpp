@@ -0,0 +1,186 @@
+#include <catch2/catch.hpp>
+#include <copc-lib/geometry/box.hpp>
+#include <copc-lib/io/copc_reader.hpp>
+#include <copc-lib/io/copc_writer.hpp>
+#include <copc-lib/las/point_buffer.hpp>
+#include <copc-lib/las/points.hpp>
+
+using namespace copc;
+using namespace copc::las;
+using namespace std;
+
+namespace
+{
+Points MakePoints(int8_t point_format_id, uint16_t eb_byte_size, int count)
+{
+    Points points(point_format_id, eb_byte_size);
+    for (int i = 0; i < count; i++)
+    {
+        auto point = points.CreatePoint();
+        point->X(i * 1.5);
+        point->Y(i * -2.25);
+        point->Z(i * 0.5);
+        point->Intensity(i);
+        point->ReturnNumber(i % 15);
+        point->NumberOfReturns(15);
+        point->Classification(i % 32);
+        point->ScanAngle(-i);
+        point->UserData(i % 256);
+        point->PointSourceId(i * 2);
+        point->GPSTime(i * 10.1);
+        point->Synthetic(i % 2);
+        if (point->HasRgb())
+            point->Rgb(i, i + 1, i + 2);
+        if (point->HasNir())
+            point->Nir(i + 3);
+        point->ExtraBytes(std::vector<uint8_t>(eb_byte_size, static_cast<uint8_t>(i)));
+        points.AddPoint(point);
+    }
+    return points;
+}
+} // namespace
+
+TEST_CASE("PointBuffer tests", "[PointBuffer]")
+{
+    SECTION("Constructors")
+    {
+        PointBuffer buffer(7, 4);
+        REQUIRE(buffer.PointFormatId() == 7);
+        REQUIRE(buffer.PointRecordLength() == 40);
+        REQUIRE(buffer.EbByteSize() == 4);
+        REQUIRE(buffer.HasRgb());
+        REQUIRE(!buffer.HasNir());
+        REQUIRE(buffer.Empty());
+
+        REQUIRE_THROWS(PointBuffer(5));
+        REQUIRE_THROWS(PointBuffer(9));
+    }
+
+    SECTION("Round trip through Points")
+    {
+        for (int8_t point_format_id : {6, 7, 8})
+        {
+            auto points = MakePoints(point_format_id, 3, 50);
+            PointBuffer buffer(points);
+            REQUIRE(buffer.Size() == points.Size());
+            REQUIRE(buffer.X()[10] == points[10]->X());
+            REQUIRE(buffer.Classification()[10] == points[10]->Classification());
+            REQUIRE(buffer.ExtraBytes().size() == 50 * 3);
+
+            auto back = buffer.ToPoints();
+            REQUIRE(back.Size() == points.Size());
+            for (size_t i = 0; i < points.Size(); i++)
+                REQUIRE(*back[i] == *points[i]);
+        }
+    }
+
+    SECTION("Pack/Unpack")
+    {
+        Vector3 scale(0.01, 0.01, 0.01);
+        Vector3 offset(50, 50, 50);
+        for (int8_t point_format_id : {6, 7, 8})
+        {
+            auto points = MakePoints(point_format_id, 2, 20);
+            PointBuffer buffer(points);
+
+            // Packed bytes must match the Point-based packing exactly
+            auto packed = buffer.Pack(scale, offset);
+            REQUIRE(packed == points.Pack(scale, offset));
+
+            auto unpacked = PointBuffer::Unpack(packed, point_format_id, 2, scale, offset);
+            REQUIRE(unpacked.Size() == points.Size());
+            REQUIRE(unpacked.Pack(scale, offset) == packed);
+
+            packed.pop_back();
+            REQUIRE_THROWS(PointBuffer::Unpack(packed, point_format_id, 2, scale, offset));
+        }
+    }
+
+    SECTION("Dimension projection")
+    {
+        Vector3 scale(0.01, 0.01, 0.01);
+        Vector3 offset(50, 50, 50);
+        auto points = MakePoints(7, 2, 20);
+        auto packed = points.Pack(scale, offset);
+        auto full = PointBuffer::Unpack(packed, 7, 2, scale, offset);
+        REQUIRE(full.HasAllDimensions());
+
+        auto xyz = PointBuffer::Unpack(packed, 7, 2, scale, offset, DIM_XYZ | DIM_CLASSIFICATION);
+        REQUIRE(xyz.Size() == points.Size());
+        REQUIRE(xyz.HasDimension(DIM_XYZ));
+        REQUIRE(xyz.HasDimension(DIM_CLASSIFICATION));
+        REQUIRE(!xyz.HasDimension(DIM_GPS_TIME));
+        REQUIRE(!xyz.HasAllDimensions());
+        REQUIRE(xyz.X() == full.X());
+        REQUIRE(xyz.Y() == full.Y());
+        REQUIRE(xyz.Z() == full.Z());
+        REQUIRE(xyz.Classification() == full.Classification());
+        REQUIRE(xyz.Intensity().empty());
+        REQUIRE(xyz.GPSTime().empty());
+        REQUIRE(xyz.Red().empty());
+        REQUIRE(xyz.ExtraBytes().empty());
+
+        // Dimensions missing from the point format are dropped from the mask
+        REQUIRE(!PointBuffer(6, 0, DIM_ALL).HasDimension(DIM_RGB));
+        REQUIRE(!PointBuffer(7, 0, DIM_ALL).HasDimension(DIM_NIR));
+        REQUIRE(!PointBuffer(7, 0, DIM_ALL).HasDimension(DIM_EXTRA_BYTES));
+        REQUIRE(PointBuffer(7, 0, DIM_ALL).HasAllDimensions());
+
+        // Unheld dimensions keep their default values
+        auto point = xyz.GetPoint(3);
+        REQUIRE(point->X() == points[3]->X());
+        REQUIRE(point->Classification() == points[3]->Classification());
+        REQUIRE(point->GPSTime() == 0);
+
+        auto within = xyz.GetWithin(Box(-1, -10, -1, 5, 1, 5));
+        REQUIRE(within.Dimensions() == xyz.Dimensions());
+        REQUIRE(within.Classification().size() == within.Size());
+
+        REQUIRE_THROWS(xyz.Pack(scale, offset));
+        REQUIRE_THROWS(full.AddPoints(xyz));
+        REQUIRE_THROWS(PointBuffer::Unpack(packed, 7, 2, scale, offset, DIM_INTENSITY).GetWithin(Box::MaxBox()));
+    }
+
+    SECTION("AddPoints and GetWithin")
+    {
+        PointBuffer buffer(MakePoints(6, 0, 10));
+        buffer.AddPoints(PointBuffer(MakePoints(6, 0, 5)));
+        REQUIRE(buffer.Size() == 15);
+        REQUIRE_THROWS(buffer.AddPoints(PointBuffer(7)));
+        REQUIRE_THROWS(buffer.AddPoint(*MakePoints(6, 2, 1)[0]));
+
+        Box box(-1, -10, -1, 5, 1, 5);
+        auto within = buffer.GetWithin(box);
+        REQUIRE(within.Within(box));
+        REQUIRE(!buffer.Within(box));
+        for (size_t i = 0; i < within.Size(); i++)
+            REQUIRE(within.GetPoint(i)->Within(box));
+        REQUIRE_THROWS(buffer.GetPoint(buffer.Size()));
+    }
+
+    SECTION("Reader and Writer")
+    {
+        std::string file_path = "point_buffer_test.copc.laz";
+        auto points = MakePoints(8, 0, 100);
+        {
+            FileWriter writer(file_path, CopcConfigWriter(8));
+            writer.AddNode(VoxelKey::RootKey(), PointBuffer(points));
+            REQUIRE_THROWS(writer.AddNode(VoxelKey(1, 0, 0, 0), PointBuffer(8)));
+            REQUIRE_THROWS(writer.AddNode(VoxelKey(1, 0, 0, 0), PointBuffer(7)));
+            writer.Close();
+        }
+
+        FileReader reader(file_path);
+        auto buffer = reader.GetPointBuffer(VoxelKey::RootKey());
+        REQUIRE(buffer.Size() == points.Size());
+        REQUIRE(buffer.Pack(reader.CopcConfig().LasHeader()) ==
+                reader.GetPoints(VoxelKey::RootKey()).Pack(reader.CopcConfig().LasHeader()));
+        REQUIRE(reader.GetPointBuffer(VoxelKey(5, 0, 0, 0)).Empty());
+
+        auto xyz = reader.GetPointBuffer(VoxelKey::RootKey(), DIM_XYZ);
+        REQUIRE(xyz.Size() == points.Size());
+        REQUIRE(xyz.X() == buffer.X());
+        REQUIRE(xyz.Nir().empty());
+        REQUIRE(reader.GetPointBuffer(VoxelKey(5, 0, 0, 0), DIM_XYZ).Dimensions() == DIM_XYZ);
+    }
+}
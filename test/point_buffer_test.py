@@ -0,0 +1,111 @@
+import copclib as copc
+import pytest
+
+from .utils import generate_test_file
+
+
+def test_point_buffer():
+    buffer = copc.PointBuffer(7, eb_byte_size=4)
+    assert buffer.point_format_id == 7
+    assert buffer.point_record_length == 40
+    assert buffer.eb_byte_size == 4
+    assert buffer.has_rgb
+    assert not buffer.has_nir
+    assert len(buffer) == 0
+
+    with pytest.raises(RuntimeError):
+        copc.PointBuffer(5)
+
+    points = copc.Points(6)
+    for i in range(10):
+        point = points.CreatePoint()
+        point.x = i
+        point.y = -i
+        point.z = i / 2
+        point.classification = i
+        points.AddPoint(point)
+
+    buffer = copc.PointBuffer(points)
+    assert len(buffer) == 10
+    assert buffer.x == points.x
+    assert buffer.classification == points.classification
+    assert buffer.red == []
+
+    buffer.classification = [1] * 10
+    assert buffer.ToPoints().classification == [1] * 10
+    with pytest.raises(RuntimeError):
+        buffer.x = [1.0]
+
+
+def test_point_buffer_reader():
+    file_path = generate_test_file()
+    reader = copc.FileReader(file_path)
+    header = reader.copc_config.las_header
+
+    for node in reader.GetAllNodes():
+        buffer = reader.GetPointBuffer(node)
+        assert len(buffer) == node.point_count
+        assert buffer.Pack(header) == reader.GetPoints(node).Pack(header)
+
+        projected = reader.GetPointBuffer(
+            node, copc.Dimension.XYZ | copc.Dimension.CLASSIFICATION
+        )
+        assert len(projected) == node.point_count
+        assert projected.x == buffer.x
+        assert projected.classification == buffer.classification
+        assert projected.gps_time == []
+        assert projected.HasDimension(copc.Dimension.XYZ)
+        assert not projected.HasDimension(copc.Dimension.INTENSITY)
+        assert not projected.HasAllDimensions()
+        with pytest.raises(RuntimeError):
+            projected.Pack(header)
+
+
+def test_point_buffer_arrays():
+    np = pytest.importorskip("numpy")
+
+    points = copc.Points(6)
+    for i in range(10):
+        point = points.CreatePoint()
+        point.x = i
+        point.classification = i
+        points.AddPoint(point)
+
+    buffer = copc.PointBuffer(points)
+    x = buffer.x_array
+    assert isinstance(x, np.ndarray)
+    assert x.dtype == np.float64
+    assert x.tolist() == buffer.x
+    assert buffer.classification_array.dtype == np.uint8
+    assert buffer.classification_array.tolist() == buffer.classification
+    assert len(buffer.red_array) == 0
+
+    # The array views the buffer's memory
+    x[0] = 42
+    assert buffer.x[0] == 42
+    assert np.shares_memory(x, buffer.x_array)
+
+    # The buffer can't be resized while a view is alive, which would move the columns under it
+    classification = buffer.classification_array[2:]
+    for resize in (
+        lambda: buffer.Resize(100),
+        lambda: buffer.AddPoint(points[0]),
+        lambda: buffer.AddPoints(buffer),
+    ):
+        with pytest.raises(RuntimeError):
+            resize()
+    assert len(buffer) == 10
+    assert x.tolist() == [42.0] + [float(i) for i in range(1, 10)]
+    assert classification.tolist() == list(range(2, 10))
+
+    # Once the views are gone it can
+    del x, classification
+    buffer.Resize(20)
+    assert len(buffer) == 20
+    buffer.Resize(10)
+
+    # And keeps the buffer alive
+    x = buffer.x_array
+    del buffer
+    assert x[0] == 42
+    assert x[1:].tolist() == [float(i) for i in range(1, 10)]
@@ -464,6 +464,42 @@ TEST_CASE("Point tests", "[Point]")
         REQUIRE(point == point_other);
     }
 
+    SECTION("Raw buffer Packing and Unpacking")
+    {
+        auto scale = copc::Vector3(0.01, 0.01, 0.01);
+        auto offset = copc::Vector3(10, 20, 30);
+        for (int8_t pfid : {6, 7, 8})
+        {
+            auto point = Point(pfid, 3);
+            point.X(20);
+            point.Y(-20);
+            point.Z(100000);
+            point.Intensity(12);
+            point.ReturnsBitField(0x35);
+            point.FlagsBitField(0xA1);
+            point.Classification(7);
+            point.UserData(9);
+            point.ScanAngle(-2000);
+            point.PointSourceId(300);
+            point.GPSTime(1234.5678);
+            if (point.HasRgb())
+                point.Rgb(1, 2, 3);
+            if (point.HasNir())
+                point.Nir(4);
+            point.ExtraBytes({5, 6, 7});
+
+            // The raw buffer record must be byte-for-byte identical to the stream one
+            std::vector<char> buffer(point.PointRecordLength());
+            point.Pack(buffer.data(), scale, offset);
+            std::stringstream ss;
+            point.Pack(ss, scale, offset);
+            REQUIRE(std::string(buffer.begin(), buffer.end()) == ss.str());
+
+            auto point_other = *Point::Unpack(buffer.data(), pfid, scale, offset, point.EbByteSize());
+            REQUIRE(point == point_other);
+        }
+    }
+
     SECTION("Scaled XYZ")
     {
         int8_t pfid = 8;
@@ -0,0 +1,144 @@
+#include <catch2/catch.hpp>
+#include <copc-lib/io/copc_pread_reader.hpp>
+#include <copc-lib/io/copc_reader.hpp>
+#include <copc-lib/io/copc_writer.hpp>
+#include <thread>
+
+using namespace copc;
+using namespace std;
+
+TEST_CASE("PreadReader tests", "[PreadReader]")
+{
+    GIVEN("A written file")
+    {
+        std::string file_path = "pread_reader_test.copc.laz";
+
+        // Write a small octree, spread over a few pages
+        {
+            FileWriter writer(file_path, CopcConfigWriter(7));
+            for (int d = 0; d < 4; d++)
+            {
+                for (int i = 0; i < (1 << d); i++)
+                {
+                    VoxelKey key(d, i, i, i);
+                    las::Points points(7);
+                    for (int j = 0; j < 10 + d * 10 + i; j++)
+                    {
+                        auto point = points.CreatePoint();
+                        point->X(j);
+                        point->Y(d);
+                        point->Z(i);
+                        points.AddPoint(point);
+                    }
+                    writer.AddNode(key, points, d == 0 ? VoxelKey::RootKey() : VoxelKey(1, i >> (d - 1), i >> (d - 1),
+                                                                                          i >> (d - 1)));
+                }
+            }
+            writer.Close();
+        }
+
+        PreadReader reader(file_path);
+        FileReader file_reader(file_path);
+
+        SECTION("Matches FileReader")
+        {
+            REQUIRE(reader.FilePath() == file_path);
+            REQUIRE(reader.CopcConfig().LasHeader().PointCount() == file_reader.CopcConfig().LasHeader().PointCount());
+            REQUIRE(reader.GetAllNodes().size() == file_reader.GetAllNodes().size());
+            REQUIRE(reader.GetPageList().size() == file_reader.GetPageList().size());
+
+            for (const auto &node : file_reader.GetAllNodes())
+            {
+                REQUIRE(reader.GetPointDataCompressed(node) == file_reader.GetPointDataCompressed(node));
+                REQUIRE(reader.GetPointData(node.key) == file_reader.GetPointData(node));
+            }
+            REQUIRE(reader.GetPointData(VoxelKey(5, 4, 3, 2)).empty());
+        }
+
+        SECTION("Concurrent reads")
+        {
+            auto nodes = file_reader.GetAllNodes();
+            std::vector<std::vector<char>> expected;
+            for (const auto &node : nodes)
+                expected.push_back(file_reader.GetPointData(node));
+
+            // Each thread resolves keys through the shared (lazily loaded) hierarchy and decodes every node
+            const int num_threads = 8;
+            std::vector<std::vector<std::vector<char>>> results(num_threads);
+            std::vector<std::thread> threads;
+            for (int t = 0; t < num_threads; t++)
+            {
+                threads.emplace_back(
+                    [&, t]()
+                    {
+                        for (size_t i = 0; i < nodes.size(); i++)
+                        {
+                            const auto &key = nodes[(i + t) % nodes.size()].key;
+                            results[t].push_back(reader.GetPointData(key));
+                        }
+                    });
+            }
+            for (auto &thread : threads)
+                thread.join();
+
+            for (int t = 0; t < num_threads; t++)
+            {
+                REQUIRE(results[t].size() == nodes.size());
+                for (size_t i = 0; i < nodes.size(); i++)
+                    REQUIRE(results[t][i] == expected[(i + t) % nodes.size()]);
+            }
+        }
+
+        SECTION("LoadHierarchy")
+        {
+            // FindNode loads pages one at a time, as it walks down to each key
+            FileReader lazy_reader(file_path);
+            std::vector<Node> expected;
+            for (int d = 0; d < 4; d++)
+            {
+                for (int i = 0; i < (1 << d); i++)
+                    expected.push_back(lazy_reader.FindNode(VoxelKey(d, i, i, i)));
+            }
+
+            for (unsigned int num_threads : {1u, 4u})
+            {
+                PreadReader preloaded(file_path);
+                preloaded.LoadHierarchy(num_threads);
+                for (auto &node : expected)
+                {
+                    REQUIRE(node.IsValid());
+                    REQUIRE(node == preloaded.FindNode(node.key));
+                }
+                REQUIRE(preloaded.GetAllNodes().size() == expected.size());
+                REQUIRE(preloaded.GetPageList().size() == lazy_reader.GetPageList().size());
+                // Loading again is a no-op
+                REQUIRE_NOTHROW(preloaded.LoadHierarchy(num_threads));
+            }
+
+            FileReader preloaded_file_reader(file_path);
+            preloaded_file_reader.LoadHierarchy(4);
+            for (auto &node : expected)
+                REQUIRE(node == preloaded_file_reader.FindNode(node.key));
+        }
+
+        SECTION("Invalid node")
+        {
+            REQUIRE_THROWS(reader.GetPointData(Node()));
+            REQUIRE_THROWS(reader.GetPointDataCompressed(Node()));
+
+            Node out_of_range(Entry(VoxelKey(1, 0, 0, 0), 1ull << 40, 100, 1), VoxelKey::RootKey());
+            REQUIRE_THROWS(reader.GetPointDataCompressed(out_of_range));
+        }
+
+        SECTION("Close")
+        {
+            reader.Close();
+            REQUIRE_THROWS(reader.GetPointDataCompressed(file_reader.FindNode(VoxelKey::RootKey())));
+        }
+    }
+
+    GIVEN("An invalid file path")
+    {
+        REQUIRE_THROWS(PreadReader("invalid_path/pread_reader_test.copc.laz"));
+    }
+}
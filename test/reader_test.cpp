@@ -1,8 +1,12 @@
+#include <algorithm>
 #include <catch2/catch.hpp>
 #include <cmath>
 #include <copc-lib/io/copc_reader.hpp>
 #include <fstream>
+#include <future>
 #include <limits>
+#include <thread>
+#include <unordered_map>
 
 using namespace copc;
 using namespace std;
@@ -189,6 +193,27 @@ TEST_CASE("GetAllChildrenOfPage Test", "[Reader]")
     }
 }
 
+TEST_CASE("LoadHierarchy Test", "[Reader]")
+{
+    FileReader reader("autzen-classified.copc.laz");
+    reader.LoadHierarchy(4);
+
+    // Every node is now resolved without reading any other page
+    FileReader lazy_reader("autzen-classified.copc.laz");
+    auto node = lazy_reader.FindNode(VoxelKey(5, 9, 7, 0));
+    REQUIRE(reader.FindNode(node.key) == node);
+    REQUIRE(reader.GetAllNodes().size() == 278);
+    REQUIRE(reader.GetPageList().size() == 1);
+
+    // Lookups don't wait for a load on another thread, and whichever loads a page first adds it
+    FileReader shared_reader("autzen-classified.copc.laz");
+    auto loader = std::async(std::launch::async, [&shared_reader] { shared_reader.LoadHierarchy(4); });
+    REQUIRE(shared_reader.FindNode(node.key) == node);
+    loader.get();
+    REQUIRE(shared_reader.GetAllNodes().size() == 278);
+    REQUIRE(shared_reader.GetMaxDepth() == reader.GetMaxDepth());
+}
+
 TEST_CASE("GetPageList Test", "[Reader]")
 {
     FileReader reader("autzen-classified.copc.laz");
@@ -203,6 +228,86 @@ TEST_CASE("GetAllPoints Test", "[Reader]")
     //    REQUIRE(reader.GetAllPoints().Get().size() == reader.CopcFile().LasHeader().point_count);
 }
 
+TEST_CASE("GetPoints Multiple Nodes Test", "[Reader]")
+{
+    FileReader reader("autzen-classified.copc.laz");
+    auto header = reader.CopcConfig().LasHeader();
+    auto nodes = reader.GetNodesWithinResolution(3);
+
+    SECTION("Results are in node order")
+    {
+        // Batches with different thread counts share the reader's pool, which grows past the hardware's count for 64
+        for (unsigned int num_threads : {0u, 1u, 4u, 64u, 2u})
+        {
+            auto points = reader.GetPoints(nodes, num_threads);
+            REQUIRE(points.size() == nodes.size());
+            for (size_t i = 0; i < nodes.size(); i++)
+                REQUIRE(points[i].Pack(header) == reader.GetPoints(nodes[i]).Pack(header));
+        }
+        REQUIRE(reader.GetPoints(std::vector<Node>{}).empty());
+    }
+
+    SECTION("PointBuffers")
+    {
+        auto dimensions = las::Dimension::DIM_XYZ | las::Dimension::DIM_CLASSIFICATION;
+        for (unsigned int num_threads : {0u, 1u, 4u})
+        {
+            auto buffers = reader.GetPointBuffers(nodes, dimensions, num_threads);
+            REQUIRE(buffers.size() == nodes.size());
+            for (size_t i = 0; i < nodes.size(); i++)
+            {
+                auto expected = reader.GetPointBuffer(nodes[i], dimensions);
+                REQUIRE(buffers[i].Dimensions() == expected.Dimensions());
+                REQUIRE(buffers[i].X() == expected.X());
+                REQUIRE(buffers[i].Classification() == expected.Classification());
+            }
+        }
+        REQUIRE(reader.GetPointBuffers(std::vector<Node>{}).empty());
+    }
+
+    SECTION("Completion callback")
+    {
+        std::unordered_map<VoxelKey, size_t> point_counts;
+        reader.GetPoints(
+            nodes, [&](const Node &node, las::Points &points) { point_counts[node.key] = points.Size(); }, 4);
+        REQUIRE(point_counts.size() == nodes.size());
+        for (const auto &node : nodes)
+            REQUIRE(point_counts[node.key] == static_cast<size_t>(node.point_count));
+
+        // The callback runs on the calling thread, so it can run batches of its own, even with every worker busy
+        auto num_threads = std::max(std::thread::hardware_concurrency(), 1u) + 1;
+        size_t nested_calls = 0;
+        reader.GetPoints(
+            nodes,
+            [&](const Node &node, las::Points &points)
+            {
+                auto children = reader.GetPoints(std::vector<Node>{node, node}, num_threads);
+                REQUIRE(children.size() == 2);
+                REQUIRE(children[1].Size() == points.Size());
+                REQUIRE(reader.GetPointBuffers({node}, las::Dimension::DIM_ALL, num_threads)[0].Size() ==
+                        points.Size());
+                nested_calls++;
+            },
+            num_threads);
+        REQUIRE(nested_calls == nodes.size());
+    }
+
+    SECTION("Invalid node")
+    {
+        auto invalid_nodes = nodes;
+        invalid_nodes.push_back(Node());
+        REQUIRE_THROWS(reader.GetPoints(invalid_nodes, 4));
+    }
+
+    SECTION("Threaded queries match serial ones")
+    {
+        auto middle = (header.max + header.min) / 2;
+        Box middle_box(middle.x - 200, middle.y - 200, middle.x + 200, middle.y + 200);
+        REQUIRE(reader.GetPointsWithinBox(middle_box, 0, 4).Size() == 91178);
+        REQUIRE(reader.GetAllPoints(3, 4).Size() == reader.GetAllPoints(3, 1).Size());
+    }
+}
+
 TEST_CASE("Point Error Handling Test", "[Reader]")
 {
     GIVEN("A valid file path")
@@ -225,6 +330,153 @@ TEST_CASE("Point Error Handling Test", "[Reader]")
 
         REQUIRE_THROWS(reader.GetPointDataCompressed(invalid_node));
         REQUIRE_NOTHROW(reader.GetPointDataCompressed(valid_node));
+
+        // A node whose data runs past the end of the file fails, and leaves the reader usable
+        auto expected = reader.GetPointData(valid_node);
+        Node truncated_node = valid_node;
+        truncated_node.offset = valid_node.offset + std::numeric_limits<int32_t>::max();
+        REQUIRE_THROWS(reader.GetPointData(truncated_node));
+        REQUIRE(reader.GetPointData(valid_node) == expected);
+    }
+}
+
+TEST_CASE("GetPointData Into Buffer Test", "[Reader]")
+{
+    FileReader reader("autzen-classified.copc.laz");
+    auto nodes = reader.GetNodesWithinResolution(3);
+
+    SECTION("Reused vector")
+    {
+        std::vector<char> buffer;
+        for (const auto &node : nodes)
+        {
+            reader.GetPointData(node, buffer);
+            REQUIRE(buffer.size() == reader.PointDataSize(node));
+            REQUIRE(buffer == reader.GetPointData(node));
+        }
+        REQUIRE_THROWS(reader.GetPointData(Node(), buffer));
+    }
+
+    SECTION("Raw buffer")
+    {
+        auto node = nodes.front();
+        auto size = reader.PointDataSize(node);
+        REQUIRE(size == node.point_count * reader.CopcConfig().LasHeader().PointRecordLength());
+
+        std::vector<char> buffer(size + 10, 'a');
+        reader.GetPointData(node, buffer.data(), buffer.size());
+        REQUIRE(std::vector<char>(buffer.begin(), buffer.begin() + size) == reader.GetPointData(node));
+        // Bytes past the node's data are left untouched
+        REQUIRE(buffer.back() == 'a');
+
+        REQUIRE_THROWS(reader.GetPointData(node, buffer.data(), size - 1));
+    }
+}
+
+TEST_CASE("Node Cache Test", "[Reader]")
+{
+    FileReader reader("autzen-classified.copc.laz");
+    auto nodes = reader.GetNodesWithinResolution(3);
+    std::vector<std::vector<char>> expected;
+    size_t total_bytes = 0;
+    for (const auto &node : nodes)
+    {
+        expected.push_back(reader.GetPointData(node));
+        total_bytes += expected.back().size();
+    }
+
+    // Disabled by default
+    REQUIRE(reader.GetNodeCacheStats().max_bytes == 0);
+
+    SECTION("Hits and misses")
+    {
+        reader.EnableNodeCache(total_bytes);
+        for (int pass = 0; pass < 2; pass++)
+        {
+            for (size_t i = 0; i < nodes.size(); i++)
+                REQUIRE(reader.GetPointData(nodes[i]) == expected[i]);
+        }
+
+        auto stats = reader.GetNodeCacheStats();
+        REQUIRE(stats.misses == nodes.size());
+        REQUIRE(stats.hits == nodes.size());
+        REQUIRE(stats.evictions == 0);
+        REQUIRE(stats.node_count == nodes.size());
+        REQUIRE(stats.bytes == total_bytes);
+        REQUIRE(stats.max_bytes == total_bytes);
+
+        // Every entry point goes through the cache
+        REQUIRE(reader.GetPoints(nodes[0]).Pack(reader.CopcConfig().LasHeader()) == expected[0]);
+        REQUIRE(reader.GetPointBuffer(nodes[0].key).Size() == static_cast<size_t>(nodes[0].point_count));
+        std::vector<char> buffer(expected[0].size());
+        reader.GetPointData(nodes[0], buffer.data(), buffer.size());
+        REQUIRE(buffer == expected[0]);
+        REQUIRE_THROWS(reader.GetPointData(nodes[0], buffer.data(), buffer.size() - 1));
+        REQUIRE(reader.GetNodeCacheStats().hits == nodes.size() + 4);
+
+        reader.ClearNodeCache();
+        REQUIRE(reader.GetNodeCacheStats().bytes == 0);
+        REQUIRE(reader.GetNodeCacheStats().node_count == 0);
+    }
+
+    SECTION("Eviction")
+    {
+        // Only room for the last node read
+        reader.EnableNodeCache(expected[0].size() + expected[1].size() - 1);
+        REQUIRE(reader.GetPointData(nodes[0]) == expected[0]);
+        REQUIRE(reader.GetPointData(nodes[1]) == expected[1]);
+        REQUIRE(reader.GetPointData(nodes[0]) == expected[0]);
+
+        auto stats = reader.GetNodeCacheStats();
+        REQUIRE(stats.misses == 3);
+        REQUIRE(stats.hits == 0);
+        REQUIRE(stats.evictions == 2);
+        REQUIRE(stats.node_count == 1);
+        REQUIRE(stats.bytes == expected[0].size());
+    }
+
+    SECTION("Least recently used first")
+    {
+        // Room for the first node and either of the next two, but not all three
+        reader.EnableNodeCache(expected[0].size() + std::max(expected[1].size(), expected[2].size()));
+        reader.GetPointData(nodes[0]);
+        reader.GetPointData(nodes[1]);
+        // Touch the first node, so the second one is the least recently used
+        reader.GetPointData(nodes[0]);
+        reader.GetPointData(nodes[2]);
+        REQUIRE(reader.GetNodeCacheStats().evictions == 1);
+
+        auto stats = reader.GetNodeCacheStats();
+        reader.GetPointData(nodes[0]);
+        REQUIRE(reader.GetNodeCacheStats().hits == stats.hits + 1);
+        reader.GetPointData(nodes[1]);
+        REQUIRE(reader.GetNodeCacheStats().misses == stats.misses + 1);
+    }
+
+    SECTION("Nodes larger than the budget aren't cached")
+    {
+        reader.EnableNodeCache(1);
+        REQUIRE(reader.GetPointData(nodes[0]) == expected[0]);
+        REQUIRE(reader.GetNodeCacheStats().node_count == 0);
+    }
+
+    SECTION("Parallel reads")
+    {
+        reader.EnableNodeCache(total_bytes);
+        auto points = reader.GetPoints(nodes, 4);
+        points = reader.GetPoints(nodes, 4);
+        for (size_t i = 0; i < nodes.size(); i++)
+            REQUIRE(points[i].Pack(reader.CopcConfig().LasHeader()) == expected[i]);
+        REQUIRE(reader.GetNodeCacheStats().hits == nodes.size());
+    }
+
+    SECTION("Disabling")
+    {
+        reader.EnableNodeCache(total_bytes);
+        reader.GetPointData(nodes[0]);
+        reader.EnableNodeCache(0);
+        REQUIRE(reader.GetNodeCacheStats().node_count == 0);
+        REQUIRE(reader.GetPointData(nodes[0]) == expected[0]);
     }
 }
 
@@ -254,6 +506,41 @@ TEST_CASE("Spatial Query Functions", "[Reader]")
         REQUIRE(subset_nodes.size() == 13);
     }
 
+    SECTION("Pruned traversal matches a full scan")
+    {
+        std::vector<Box> boxes{middle_box, Box::MaxBox(), Box(middle.x, middle.y, middle.x + 50, middle.y + 50)};
+        for (const auto &box : boxes)
+        {
+            for (double resolution : {0.0, 3.0})
+            {
+                auto max_depth = reader.GetDepthAtResolution(resolution);
+                std::unordered_map<VoxelKey, Node> expected_intersect;
+                std::unordered_map<VoxelKey, Node> expected_within;
+                for (const auto &node : reader.GetAllNodes())
+                {
+                    if (node.key.d > max_depth)
+                        continue;
+                    if (node.key.Intersects(reader.CopcConfig().LasHeader(), box))
+                        expected_intersect[node.key] = node;
+                    if (node.key.Within(reader.CopcConfig().LasHeader(), box))
+                        expected_within[node.key] = node;
+                }
+
+                // Use a fresh reader, so that the hierarchy pages get loaded by the traversal
+                FileReader fresh_reader("autzen-classified.copc.laz");
+                auto intersect = fresh_reader.GetNodesIntersectBox(box, resolution);
+                REQUIRE(intersect.size() == expected_intersect.size());
+                for (const auto &node : intersect)
+                    REQUIRE(expected_intersect.count(node.key) == 1);
+
+                auto within = fresh_reader.GetNodesWithinBox(box, resolution);
+                REQUIRE(within.size() == expected_within.size());
+                for (const auto &node : within)
+                    REQUIRE(expected_within.count(node.key) == 1);
+            }
+        }
+    }
+
     SECTION("GetPointsWithinBox")
     {
         {
@@ -280,6 +567,93 @@ TEST_CASE("Spatial Query Functions", "[Reader]")
         }
     }
 
+    SECTION("QueryPointsWithinBox")
+    {
+        {
+            auto cursor = reader.QueryPointsWithinBox(Box::EmptyBox());
+            las::Points points(reader.CopcConfig().LasHeader());
+            REQUIRE(!cursor.Next(points));
+            REQUIRE(points.Size() == 0);
+        }
+        for (unsigned int prefetch : {0, 1, 4})
+        {
+            auto cursor = reader.QueryPointsWithinBox(middle_box, 0, prefetch);
+            REQUIRE(cursor.NodeCount() == 13);
+
+            las::Points points(reader.CopcConfig().LasHeader());
+            size_t total = 0;
+            while (cursor.Next(points))
+            {
+                REQUIRE(points.Size() > 0);
+                REQUIRE(points.Size() <= static_cast<size_t>(cursor.CurrentNode().point_count));
+                for (const auto &point : points.Get())
+                    REQUIRE(point->Within(middle_box));
+                total += points.Size();
+            }
+            REQUIRE(total == 91178);
+            REQUIRE(cursor.NodesRead() == cursor.NodeCount());
+            REQUIRE(!cursor.Next(points));
+        }
+        {
+            // A cursor can be dropped with nodes still being decoded
+            auto cursor = reader.QueryPointsWithinBox(middle_box, 0, 4);
+            las::Points points(reader.CopcConfig().LasHeader());
+            REQUIRE(cursor.Next(points));
+        }
+        {
+            // Cursors don't resize the reader's pool, so one can be read while a batch runs on it
+            auto cursor = reader.QueryPointsWithinBox(middle_box, 0, 2);
+            las::Points points(reader.CopcConfig().LasHeader());
+            REQUIRE(cursor.Next(points));
+            REQUIRE(reader.GetPointsWithinBox(middle_box, 0, 3).Size() == 91178);
+            size_t total = points.Size();
+            while (cursor.Next(points))
+                total += points.Size();
+            REQUIRE(total == 91178);
+        }
+    }
+
+    SECTION("Attribute Query Functions")
+    {
+        // The file has no node statistics, so no node can be skipped
+        REQUIRE(!reader.HasNodeStats());
+        NodeStats stats;
+        REQUIRE(!reader.GetNodeStats(VoxelKey::RootKey(), stats));
+
+        auto filter = PointFilter().In(FIELD_CLASSIFICATION, {2, 6}).Range(FIELD_INTENSITY, 0, 100);
+        REQUIRE(reader.GetNodesWithFilter(filter, middle_box).size() == 13);
+        REQUIRE(reader.GetNodesWithFilter(filter).size() == reader.GetAllNodes().size());
+
+        // Same points as filtering a box query by hand
+        size_t expected = 0;
+        for (const auto &point : reader.GetPointsWithinBox(middle_box).Get())
+        {
+            if ((point->Classification() == 2 || point->Classification() == 6) && point->Intensity() <= 100)
+                expected++;
+        }
+        REQUIRE(expected > 0);
+        REQUIRE(expected < 91178);
+        for (unsigned int num_threads : {1, 4})
+        {
+            auto points = reader.GetPointsWithFilter(filter, middle_box, 0, las::Dimension::DIM_CLASSIFICATION,
+                                                     num_threads);
+            REQUIRE(points.Size() == expected);
+            // The dimensions needed by the filter and the box are decoded too
+            REQUIRE(points.HasDimension(las::Dimension::DIM_XYZ));
+            REQUIRE(points.HasDimension(las::Dimension::DIM_INTENSITY));
+            REQUIRE(!points.HasDimension(las::Dimension::DIM_GPS_TIME));
+            REQUIRE(points.Within(middle_box));
+            for (size_t i = 0; i < points.Size(); i++)
+            {
+                REQUIRE((points.Classification()[i] == 2 || points.Classification()[i] == 6));
+                REQUIRE(points.Intensity()[i] <= 100);
+            }
+        }
+
+        // An empty filter is a plain box query
+        REQUIRE(reader.GetPointsWithFilter(PointFilter(), middle_box).Size() == 91178);
+    }
+
     SECTION("GetDepthAtResolution")
     {
         REQUIRE(reader.GetDepthAtResolution(3) == 4);
@@ -288,7 +662,18 @@ TEST_CASE("Spatial Query Functions", "[Reader]")
         REQUIRE(reader.GetDepthAtResolution(std::numeric_limits<double>::max()) == 0);
     }
 
-    SECTION("GetMaxDepth") { REQUIRE(reader.GetMaxDepth() == 5); }
+    SECTION("GetMaxDepth")
+    {
+        REQUIRE(reader.GetMaxDepth() == 5);
+
+        // The depth gets cached, and must not be affected by partially loaded hierarchies
+        FileReader fresh_reader("autzen-classified.copc.laz");
+        REQUIRE(fresh_reader.FindNode(VoxelKey::RootKey()).IsValid());
+        REQUIRE(fresh_reader.GetNodesWithinResolution(3).size() == 257);
+        REQUIRE(fresh_reader.GetMaxDepth() == 5);
+        REQUIRE(fresh_reader.GetMaxDepth() == 5);
+        REQUIRE(fresh_reader.GetDepthAtResolution(3) == 4);
+    }
 
     SECTION("GetNodesAtResolution")
     {
@@ -148,6 +148,77 @@ def test_point_error_handling():
     reader.GetPointDataCompressed(valid_node)
 
 
+def test_get_points_multiple_nodes():
+    reader = copc.FileReader(get_autzen_file())
+    nodes = reader.GetNodesWithinResolution(3)
+
+    for num_threads in [0, 1, 4]:
+        points = reader.GetPoints(nodes, num_threads=num_threads)
+        assert len(points) == len(nodes)
+        for node, node_points in zip(nodes, points):
+            assert len(node_points) == node.point_count
+
+    with pytest.raises(RuntimeError):
+        reader.GetPoints(nodes + [copc.Node()], num_threads=4)
+
+    dimensions = copc.Dimension.XYZ | copc.Dimension.CLASSIFICATION
+    buffers = reader.GetPointBuffers(nodes, dimensions, num_threads=4)
+    assert len(buffers) == len(nodes)
+    for node, buffer in zip(nodes, buffers):
+        assert len(buffer) == node.point_count
+        assert buffer.x == reader.GetPointBuffer(node, dimensions).x
+
+    header = reader.copc_config.las_header
+    points = reader.GetPoints(nodes[:4])
+    compressed = copc.CompressPoints(points, header, num_threads=4)
+    assert len(compressed) == 4
+    for node_points, data in zip(points, compressed):
+        assert data == copc.CompressBytes(node_points.Pack(header), header)
+
+
+def test_get_point_data_into_buffer():
+    reader = copc.FileReader(get_autzen_file())
+
+    buffer = copc.VectorChar()
+    for node in reader.GetNodesWithinResolution(3):
+        reader.GetPointData(node, buffer)
+        assert len(buffer) == reader.PointDataSize(node)
+        assert buffer == reader.GetPointData(node)
+
+
+def test_load_hierarchy():
+    reader = copc.FileReader(get_autzen_file())
+    reader.LoadHierarchy(num_threads=4)
+    assert len(reader.GetAllNodes()) == 278
+    assert len(reader.GetPageList()) == 1
+
+
+def test_node_cache():
+    reader = copc.FileReader(get_autzen_file())
+    nodes = reader.GetNodesWithinResolution(3)
+    expected = [reader.GetPointData(node) for node in nodes]
+    total_bytes = sum(len(data) for data in expected)
+
+    reader.EnableNodeCache(total_bytes)
+    for _ in range(2):
+        for node, data in zip(nodes, expected):
+            assert reader.GetPointData(node) == data
+
+    stats = reader.GetNodeCacheStats()
+    assert stats.misses == len(nodes)
+    assert stats.hits == len(nodes)
+    assert stats.evictions == 0
+    assert stats.node_count == len(nodes)
+    assert stats.bytes == total_bytes
+    assert stats.max_bytes == total_bytes
+
+    reader.ClearNodeCache()
+    assert reader.GetNodeCacheStats().node_count == 0
+
+    reader.EnableNodeCache(0)
+    assert reader.GetNodeCacheStats().max_bytes == 0
+
+
 def test_spatial_query_functions():
 
     reader = copc.FileReader(get_autzen_file())
@@ -196,6 +267,42 @@ def test_spatial_query_functions():
     subset_points = reader.GetPointsWithinBox(middle_box)
     assert len(subset_points) == 91178
 
+    # QueryPointsWithinBox
+    assert len(list(reader.QueryPointsWithinBox(copc.Box.EmptyBox()))) == 0
+    for prefetch in [0, 4]:
+        cursor = reader.QueryPointsWithinBox(middle_box, prefetch=prefetch)
+        assert cursor.node_count == 13
+        total = 0
+        for points in cursor:
+            assert 0 < len(points) <= cursor.current_node.point_count
+            total += len(points)
+        assert total == 91178
+        assert cursor.nodes_read == cursor.node_count
+
+    # GetPointsWithFilter
+    ## The file has no node statistics, so no node can be skipped
+    assert not reader.HasNodeStats()
+    assert reader.GetNodeStats(copc.VoxelKey.RootKey()) is None
+    point_filter = (
+        copc.PointFilter()
+        .In(copc.PointField.CLASSIFICATION, [2, 6])
+        .Range(copc.PointField.INTENSITY, 0, 100)
+    )
+    assert len(reader.GetNodesWithFilter(point_filter, middle_box)) == 13
+
+    expected = [
+        point
+        for point in reader.GetPointsWithinBox(middle_box)
+        if point.classification in (2, 6) and point.intensity <= 100
+    ]
+    points = reader.GetPointsWithFilter(
+        point_filter, middle_box, dimensions=copc.Dimension.CLASSIFICATION
+    )
+    assert len(points) == len(expected)
+    assert set(points.classification) <= {2, 6}
+    assert max(points.intensity) <= 100
+    assert points.Within(middle_box)
+
     # GetDepthAtResolution
     assert reader.GetDepthAtResolution(3) == 4
     assert reader.GetDepthAtResolution(0) == 5
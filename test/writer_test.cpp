@@ -1,12 +1,19 @@
+#include <algorithm>
 #include <cstring>
+#include <future>
 #include <sstream>
 #include <string>
 
 #include <catch2/catch.hpp>
+#include <copc-lib/copc/extents_accumulator.hpp>
+#include <copc-lib/copc/node_stats.hpp>
+#include <copc-lib/copc/point_filter.hpp>
 #include <copc-lib/geometry/vector3.hpp>
 #include <copc-lib/io/copc_reader.hpp>
 #include <copc-lib/io/copc_writer.hpp>
 #include <copc-lib/las/vlr.hpp>
+#include <copc-lib/laz/compressor.hpp>
+#include <copc-lib/laz/decompressor.hpp>
 #include <lazperf/readers.hpp>
 
 using namespace copc;
@@ -637,6 +644,47 @@ TEST_CASE("Writer Pages", "[Writer]")
         REQUIRE(std::find(page_keys.begin(), page_keys.end(), VoxelKey(1, 0, 1, 1)) != page_keys.end());
     }
 
+    SECTION("Sparse Hierarchy")
+    {
+        stringstream out_stream;
+
+        CopcConfigWriter cfg(6, {0.1, 0.1, 0.1}, {0, 0, 0});
+        cfg.LasHeader()->min = {-10, -10, -5};
+        cfg.LasHeader()->max = {10, 10, 5};
+        cfg.CopcInfo()->spacing = 10;
+        Writer writer(out_stream, cfg);
+
+        auto header = *writer.CopcConfig()->LasHeader();
+        las::Points points(header.PointFormatId());
+        points.AddPoint(points.CreatePoint());
+
+        // None of these nodes have a node at depth 1 above them, and the last one's page isn't a node
+        writer.AddNode(VoxelKey(2, 3, 3, 3), points);
+        writer.AddNode(VoxelKey(3, 0, 0, 1), points);
+        writer.AddNode(VoxelKey(3, 4, 4, 4), points, VoxelKey(2, 2, 2, 2));
+
+        writer.Close();
+
+        Reader reader(&out_stream);
+        auto nodes = reader.GetNodesIntersectBox(Box::MaxBox());
+        REQUIRE(nodes.size() == 3);
+        for (const auto &key : {VoxelKey(2, 3, 3, 3), VoxelKey(3, 0, 0, 1), VoxelKey(3, 4, 4, 4)})
+        {
+            REQUIRE(std::find_if(nodes.begin(), nodes.end(), [&key](const Node &n) { return n.key == key; }) !=
+                    nodes.end());
+        }
+
+        // The descendants of missing keys are still filtered by the box and the resolution
+        auto corner = reader.GetNodesIntersectBox(Box(6, 6, 11, 9, 9, 14));
+        REQUIRE(corner.size() == 1);
+        REQUIRE(corner[0].key == VoxelKey(2, 3, 3, 3));
+        REQUIRE(corner[0].page_key == VoxelKey::RootKey());
+        // Depth 2 is at a resolution of 10 / 2^2
+        auto shallow = reader.GetNodesIntersectBox(Box::MaxBox(), 2.5);
+        REQUIRE(shallow.size() == 1);
+        REQUIRE(shallow[0].key == VoxelKey(2, 3, 3, 3));
+    }
+
     SECTION("Change Node Page")
     {
         stringstream out_stream;
@@ -785,6 +833,323 @@ TEST_CASE("Writer Copy", "[Writer]")
         REQUIRE(new_reader.GetPointData(new_reader.FindNode(VoxelKey(5, 9, 7, 0))) ==
                 reader.GetPointData(reader.FindNode(VoxelKey(5, 9, 7, 0))));
     }
+
+    SECTION("Parallel compression")
+    {
+        FileReader reader("autzen-classified.copc.laz");
+        auto cfg = reader.CopcConfig();
+
+        // Limit the node count so the test doesn't take too long
+        auto nodes = reader.GetAllNodes();
+        nodes.resize(std::min<size_t>(nodes.size(), 40));
+
+        stringstream serial_stream;
+        {
+            Writer writer(serial_stream, cfg);
+            for (const auto &node : nodes)
+                writer.AddNode(node.key, reader.GetPointData(node), node.page_key);
+            writer.Close();
+        }
+
+        stringstream parallel_stream;
+        {
+            Writer writer(parallel_stream, cfg);
+            writer.EnableParallelCompression(4);
+            for (const auto &node : nodes)
+            {
+                auto added = writer.AddNode(node.key, reader.GetPointData(node), node.page_key);
+                REQUIRE(added.point_count == node.point_count);
+            }
+            writer.Flush();
+            for (const auto &node : nodes)
+                REQUIRE(writer.FindNode(node.key).IsValid());
+            writer.Close();
+        }
+
+        // Nodes are written in the order they were added, so the files must match exactly
+        REQUIRE(parallel_stream.str() == serial_stream.str());
+
+        Reader new_reader(&parallel_stream);
+        for (const auto &node : nodes)
+            REQUIRE(new_reader.GetPointData(new_reader.FindNode(node.key)) == reader.GetPointData(node));
+    }
+
+    SECTION("Async AddNode")
+    {
+        FileReader reader("autzen-classified.copc.laz");
+        auto cfg = reader.CopcConfig();
+
+        auto nodes = reader.GetAllNodes();
+        nodes.resize(std::min<size_t>(nodes.size(), 40));
+
+        stringstream out_stream;
+        {
+            Writer writer(out_stream, cfg);
+            // A small budget, so that adding nodes has to wait on the writer thread
+            writer.EnableParallelCompression(2, 1024 * 1024);
+
+            std::vector<std::future<Node>> futures;
+            for (const auto &node : nodes)
+                futures.push_back(writer.AddNodeAsync(node.key, reader.GetPoints(node), node.page_key));
+            REQUIRE_THROWS(writer.AddNodeAsync(VoxelKey(1, 0, 0, 0), las::Points(cfg.LasHeader())));
+            REQUIRE_THROWS(writer.AddNodeAsync(VoxelKey(1, 0, 0, 0), reader.GetPoints(nodes[0]), VoxelKey(1, 1, 1, 1)));
+
+            for (size_t i = 0; i < nodes.size(); i++)
+            {
+                auto written = futures[i].get();
+                REQUIRE(written.IsValid());
+                REQUIRE(written.key == nodes[i].key);
+                REQUIRE(written.point_count == nodes[i].point_count);
+                REQUIRE(written == writer.FindNode(nodes[i].key));
+            }
+            writer.Close();
+        }
+
+        Reader new_reader(&out_stream);
+        for (const auto &node : nodes)
+            REQUIRE(new_reader.GetPointData(new_reader.FindNode(node.key)) == reader.GetPointData(node));
+    }
+
+    SECTION("Async AddNode without parallel compression")
+    {
+        FileReader reader("autzen-classified.copc.laz");
+        auto cfg = reader.CopcConfig();
+        auto nodes = reader.GetAllNodes();
+        nodes.resize(std::min<size_t>(nodes.size(), 10));
+
+        stringstream out_stream;
+        {
+            Writer writer(out_stream, cfg);
+            std::vector<std::future<Node>> futures;
+            for (size_t i = 0; i + 1 < nodes.size(); i++)
+                futures.push_back(writer.AddNodeAsync(nodes[i].key, reader.GetPoints(nodes[i]), nodes[i].page_key));
+
+            // AddNode still returns the written node, after the queued ones
+            auto last = writer.AddNode(nodes.back().key, reader.GetPoints(nodes.back()), nodes.back().page_key);
+            REQUIRE(last.offset > 0);
+            REQUIRE(last.byte_size > 0);
+            for (auto &future : futures)
+                REQUIRE(future.get().offset < last.offset);
+            writer.Close();
+        }
+
+        Reader new_reader(&out_stream);
+        for (const auto &node : nodes)
+            REQUIRE(new_reader.GetPointData(new_reader.FindNode(node.key)) == reader.GetPointData(node));
+    }
+
+    SECTION("Failed node")
+    {
+        FileReader reader("autzen-classified.copc.laz");
+        auto cfg = reader.CopcConfig();
+        auto node = reader.FindNode(VoxelKey(5, 9, 7, 0));
+        // Node stats decode compressed nodes on the pipeline, which fails on a truncated chunk
+        auto truncated = reader.GetPointDataCompressed(node);
+        truncated.resize(truncated.size() / 2);
+
+        stringstream out_stream;
+        {
+            Writer writer(out_stream, cfg);
+            writer.EnableNodeStats();
+            writer.EnableParallelCompression(2);
+            writer.AddNodeCompressed(node.key, truncated, node.point_count, node.page_key);
+            REQUIRE_THROWS(writer.Flush());
+            REQUIRE_THROWS(writer.Close());
+        }
+        // Destroying a writer that was never closed drops the error rather than throwing from the destructor
+        {
+            Writer writer(out_stream, cfg);
+            writer.EnableNodeStats();
+            writer.EnableParallelCompression(2);
+            writer.AddNodeCompressed(node.key, truncated, node.point_count, node.page_key);
+        }
+        {
+            FileWriter writer("writer_test.copc.laz", cfg);
+            writer.EnableNodeStats();
+            writer.EnableParallelCompression(2);
+            writer.AddNodeCompressed(node.key, truncated, node.point_count, node.page_key);
+        }
+    }
+
+    SECTION("Node stats")
+    {
+        FileReader reader("autzen-classified.copc.laz");
+        auto cfg = reader.CopcConfig();
+
+        auto nodes = reader.GetAllNodes();
+        nodes.resize(std::min<size_t>(nodes.size(), 20));
+
+        for (bool parallel : {false, true})
+        {
+            stringstream out_stream;
+            {
+                Writer writer(out_stream, cfg);
+                writer.EnableNodeStats();
+                if (parallel)
+                    writer.EnableParallelCompression(4);
+                // Uncompressed and compressed nodes both get stats
+                for (size_t i = 0; i < nodes.size(); i++)
+                {
+                    if (i % 2 == 0)
+                        writer.AddNode(nodes[i].key, reader.GetPointData(nodes[i]), nodes[i].page_key);
+                    else
+                        writer.AddNodeCompressed(nodes[i].key, reader.GetPointDataCompressed(nodes[i]),
+                                                 nodes[i].point_count, nodes[i].page_key);
+                }
+                writer.Flush();
+                REQUIRE(writer.FindNode(nodes[0].key).stats->PointCount() == nodes[0].point_count);
+                writer.Close();
+            }
+
+            Reader new_reader(&out_stream);
+            REQUIRE(new_reader.HasNodeStats());
+            for (const auto &node : nodes)
+            {
+                auto new_node = new_reader.FindNode(node.key);
+                REQUIRE(new_node.stats);
+                REQUIRE(new_node.stats->ToString() == NodeStats::FromPoints(reader.GetPointBuffer(node)).ToString());
+            }
+
+            // A class that no written node holds rules every node out
+            auto filter = PointFilter().In(FIELD_CLASSIFICATION, {200});
+            REQUIRE(new_reader.GetNodesWithFilter(filter).empty());
+            filter = PointFilter().In(FIELD_CLASSIFICATION, {2});
+            for (const auto &node : new_reader.GetNodesWithFilter(filter))
+                REQUIRE(node.stats->ClassificationCount(2) > 0);
+        }
+
+        // Files written without stats don't have the EVLR
+        stringstream out_stream;
+        {
+            Writer writer(out_stream, cfg);
+            writer.AddNode(nodes[0].key, reader.GetPointData(nodes[0]), nodes[0].page_key);
+            REQUIRE(!writer.FindNode(nodes[0].key).stats);
+            writer.Close();
+        }
+        Reader new_reader(&out_stream);
+        REQUIRE(!new_reader.HasNodeStats());
+        REQUIRE(!new_reader.FindNode(nodes[0].key).stats);
+    }
+
+    SECTION("Auto extents")
+    {
+        FileReader reader("autzen-classified.copc.laz");
+        auto cfg = reader.CopcConfig();
+
+        auto nodes = reader.GetAllNodes();
+        nodes.resize(std::min<size_t>(nodes.size(), 20));
+
+        ExtentsAccumulator expected;
+        for (const auto &node : nodes)
+            expected.Add(reader.GetPointBuffer(node));
+
+        for (bool parallel : {false, true})
+        {
+            stringstream out_stream;
+            {
+                Writer writer(out_stream, cfg, {}, {}, {}, {}, {}, true);
+                writer.EnableAutoExtents();
+                if (parallel)
+                    writer.EnableParallelCompression(4);
+                // Uncompressed and compressed nodes are both accumulated
+                for (size_t i = 0; i < nodes.size(); i++)
+                {
+                    if (i % 2 == 0)
+                        writer.AddNode(nodes[i].key, reader.GetPointData(nodes[i]), nodes[i].page_key);
+                    else
+                        writer.AddNodeCompressed(nodes[i].key, reader.GetPointDataCompressed(nodes[i]),
+                                                 nodes[i].point_count, nodes[i].page_key);
+                }
+                writer.Flush();
+                REQUIRE(writer.AccumulatedExtents().PointCount() == expected.PointCount());
+                writer.Close();
+            }
+
+            Reader new_reader(&out_stream);
+            auto header = new_reader.CopcConfig().LasHeader();
+            REQUIRE(header.min == Vector3(expected.Extent(FIELD_X).minimum, expected.Extent(FIELD_Y).minimum,
+                                          expected.Extent(FIELD_Z).minimum));
+            REQUIRE(header.max == Vector3(expected.Extent(FIELD_X).maximum, expected.Extent(FIELD_Y).maximum,
+                                          expected.Extent(FIELD_Z).maximum));
+
+            auto extents = new_reader.CopcConfig().CopcExtents();
+            REQUIRE(extents.HasExtendedStats());
+            auto intensity = expected.Extent(FIELD_INTENSITY);
+            REQUIRE(extents.Intensity()->minimum == intensity.minimum);
+            REQUIRE(extents.Intensity()->maximum == intensity.maximum);
+            REQUIRE(extents.Intensity()->mean == Approx(intensity.mean));
+            REQUIRE(extents.Intensity()->var == Approx(intensity.var));
+            REQUIRE(extents.GpsTime()->maximum == expected.Extent(FIELD_GPS_TIME).maximum);
+            REQUIRE(extents.Classification()->maximum == expected.Extent(FIELD_CLASSIFICATION).maximum);
+        }
+    }
+}
+
+TEST_CASE("Compressor", "[Writer]")
+{
+    FileReader reader("autzen-classified.copc.laz");
+    auto header = reader.CopcConfig().LasHeader();
+    auto node = reader.FindNode(VoxelKey(5, 9, 7, 0));
+    auto points = reader.GetPoints(node);
+    auto uncompressed = points.Pack(header);
+
+    auto compressed = laz::Compressor::CompressBytes(uncompressed, header);
+    REQUIRE(laz::Decompressor::DecompressBytes(compressed, header, node.point_count) == uncompressed);
+
+    // All the entry points must produce the same bytes
+    REQUIRE(laz::Compressor::CompressBytes(uncompressed.data(), uncompressed.size(), header.PointFormatId(),
+                                           header.EbByteSize()) == compressed);
+    REQUIRE(laz::Compressor::CompressPoints(points, header) == compressed);
+    REQUIRE(laz::Compressor::CompressPoints(las::PointBuffer(points), header) == compressed);
+    for (unsigned int num_threads : {0u, 1u, 4u})
+    {
+        auto batch = laz::Compressor::CompressPoints(std::vector<las::Points>{points, points, points}, header,
+                                                     num_threads);
+        REQUIRE(batch.size() == 3);
+        for (const auto &chunk : batch)
+            REQUIRE(chunk == compressed);
+
+        // The packed points can be accumulated as they're compressed
+        ExtentsAccumulator extents;
+        REQUIRE(laz::Compressor::CompressPoints(std::vector<las::Points>{points, points}, header, num_threads,
+                                                &extents) == std::vector<std::vector<char>>{compressed, compressed});
+        ExtentsAccumulator expected;
+        expected.Add(las::PointBuffer::Unpack(uncompressed, header));
+        expected.Add(las::PointBuffer::Unpack(uncompressed, header));
+        REQUIRE(extents.ToString() == expected.ToString());
+    }
+
+    stringstream out_stream;
+    REQUIRE(laz::Compressor::CompressBytes(out_stream, header, uncompressed) == node.point_count);
+    auto streamed = out_stream.str();
+    REQUIRE(std::vector<char>(streamed.begin(), streamed.end()) == compressed);
+
+    REQUIRE_THROWS(laz::Compressor::CompressBytes(uncompressed.data(), uncompressed.size() - 1,
+                                                  header.PointFormatId(), header.EbByteSize()));
+    REQUIRE_THROWS(laz::Compressor::CompressPoints(las::Points(6), header));
+    REQUIRE_THROWS(laz::Compressor::CompressPoints(
+        las::PointBuffer::Unpack(uncompressed, header, las::Dimension::DIM_XYZ), header));
+}
+
+TEST_CASE("Decompressor", "[Writer]")
+{
+    FileReader reader("autzen-classified.copc.laz");
+    auto header = reader.CopcConfig().LasHeader();
+    auto node = reader.FindNode(VoxelKey(5, 9, 7, 0));
+    auto compressed = reader.GetPointDataCompressed(node);
+    std::vector<char> out(reader.PointDataSize(node));
+
+    laz::Decompressor::DecompressBytes(compressed.data(), compressed.size(), header, node.point_count, out.data(),
+                                       out.size());
+    REQUIRE(out == reader.GetPointData(node));
+
+    REQUIRE_THROWS(laz::Decompressor::DecompressBytes(compressed.data(), compressed.size(), header,
+                                                      node.point_count, out.data(), out.size() - 1));
+    // Truncated chunks are an error, rather than points decoded from zeros, even when a single byte is missing
+    REQUIRE_THROWS(laz::Decompressor::DecompressBytes(compressed.data(), compressed.size() / 2, header,
+                                                      node.point_count));
+    REQUIRE_THROWS(laz::Decompressor::DecompressBytes(compressed.data(), compressed.size() - 1, header,
+                                                      node.point_count));
 }
 
 TEST_CASE("Check Spatial Bounds", "[Writer]")
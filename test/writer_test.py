@@ -336,6 +336,92 @@ def test_writer_copy():
     ) == reader.GetPointData(reader.FindNode((5, 9, 7, 0)))
 
 
+def test_writer_parallel_compression():
+    reader = copc.FileReader(get_autzen_file())
+    cfg = reader.copc_config
+    # Limit the node count so the test doesn't take too long
+    nodes = reader.GetAllNodes()[:20]
+
+    serial_path = os.path.join(get_data_dir(), "writer_serial_test.copc.laz")
+    writer = copc.FileWriter(serial_path, cfg)
+    for node in nodes:
+        writer.AddNode(node.key, reader.GetPointData(node), node.page_key)
+    writer.Close()
+
+    parallel_path = os.path.join(get_data_dir(), "writer_parallel_test.copc.laz")
+    writer = copc.FileWriter(parallel_path, cfg)
+    writer.EnableParallelCompression(num_threads=4)
+    for node in nodes:
+        writer.AddNode(node.key, reader.GetPointData(node), node.page_key)
+    writer.Flush()
+    for node in nodes:
+        assert writer.FindNode(node.key).IsValid()
+    writer.Close()
+
+    # Nodes are written in the order they were added, so the files must match exactly
+    with open(serial_path, "rb") as serial, open(parallel_path, "rb") as parallel:
+        assert serial.read() == parallel.read()
+
+
+def test_writer_node_stats():
+    reader = copc.FileReader(get_autzen_file())
+    cfg = reader.copc_config
+    nodes = reader.GetAllNodes()[:20]
+
+    file_path = os.path.join(get_data_dir(), "writer_node_stats_test.copc.laz")
+    writer = copc.FileWriter(file_path, cfg)
+    writer.EnableNodeStats()
+    for node in nodes:
+        writer.AddNode(node.key, reader.GetPointData(node), node.page_key)
+    assert writer.FindNode(nodes[0].key).stats.point_count == nodes[0].point_count
+    writer.Close()
+
+    new_reader = copc.FileReader(file_path)
+    assert new_reader.HasNodeStats()
+    for node in nodes:
+        stats = new_reader.FindNode(node.key).stats
+        assert stats is not None
+        assert str(stats) == str(
+            copc.NodeStats.FromPoints(reader.GetPointBuffer(node))
+        )
+
+    point_filter = copc.PointFilter().In(copc.PointField.CLASSIFICATION, [200])
+    assert len(new_reader.GetNodesWithFilter(point_filter)) == 0
+
+    # Files written without stats don't have the EVLR
+    assert reader.FindNode(nodes[0].key).stats is None
+
+
+def test_writer_auto_extents():
+    reader = copc.FileReader(get_autzen_file())
+    cfg = reader.copc_config
+    nodes = reader.GetAllNodes()[:20]
+
+    expected = copc.ExtentsAccumulator()
+    for node in nodes:
+        expected.Add(reader.GetPointBuffer(node))
+
+    file_path = os.path.join(get_data_dir(), "writer_auto_extents_test.copc.laz")
+    writer = copc.FileWriter(file_path, cfg)
+    writer.EnableAutoExtents()
+    for node in nodes:
+        writer.AddNodeCompressed(
+            node.key,
+            reader.GetPointDataCompressed(node),
+            node.point_count,
+            node.page_key,
+        )
+    assert writer.AccumulatedExtents().point_count == expected.point_count
+    writer.Close()
+
+    new_reader = copc.FileReader(file_path)
+    header = new_reader.copc_config.las_header
+    assert header.min.x == expected.Extent(copc.PointField.X).minimum
+    assert header.max.z == expected.Extent(copc.PointField.Z).maximum
+    extents = new_reader.copc_config.copc_extents
+    assert extents.intensity.maximum == expected.Extent(copc.PointField.INTENSITY).maximum
+
+
 def test_writer_copy_and_update():
 
     # Create test file